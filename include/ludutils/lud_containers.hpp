@@ -0,0 +1,448 @@
+#ifndef LUD_CONTAINERS_HEADER
+#define LUD_CONTAINERS_HEADER
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Lud {
+
+/**
+ * @brief vector with a fixed capacity stored inline, never allocates and is usable in constant expressions
+ *        elements past size() are kept value initialized, so T must be default constructible
+ *
+ * @tparam T type of the elements
+ * @tparam N capacity, going over it throws std::length_error
+ */
+template <typename T, size_t N>
+class static_vector
+{
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    constexpr static_vector() = default;
+    constexpr static_vector(std::initializer_list<T> init);
+
+    constexpr iterator begin() noexcept { return m_data.data(); }
+    constexpr const_iterator begin() const noexcept { return m_data.data(); }
+    constexpr iterator end() noexcept { return m_data.data() + m_size; }
+    constexpr const_iterator end() const noexcept { return m_data.data() + m_size; }
+
+    constexpr T* data() noexcept { return m_data.data(); }
+    constexpr const T* data() const noexcept { return m_data.data(); }
+
+    constexpr size_t size() const noexcept { return m_size; }
+    constexpr bool empty() const noexcept { return m_size == 0; }
+    static constexpr size_t capacity() noexcept { return N; }
+    static constexpr size_t max_size() noexcept { return N; }
+
+    constexpr T& operator[](size_t idx) { return m_data[idx]; }
+    constexpr const T& operator[](size_t idx) const { return m_data[idx]; }
+
+    constexpr T& front() { return m_data[0]; }
+    constexpr const T& front() const { return m_data[0]; }
+    constexpr T& back() { return m_data[m_size - 1]; }
+    constexpr const T& back() const { return m_data[m_size - 1]; }
+
+    constexpr void push_back(const T& value);
+    constexpr void push_back(T&& value);
+
+    template <typename... ArgsT>
+    constexpr T& emplace_back(ArgsT&&... args);
+
+    constexpr iterator insert(const_iterator pos, const T& value);
+    constexpr iterator insert(const_iterator pos, T&& value);
+
+    constexpr void pop_back();
+    constexpr void clear();
+
+    constexpr bool operator==(const static_vector& other) const;
+
+private:
+    constexpr void check_capacity() const;
+
+private:
+    std::array<T, N> m_data{};
+    size_t m_size = 0;
+};
+
+/**
+ * @brief vector that keeps up to N elements inline and only moves to the heap when it grows past that
+ *        meant for results that are almost always small, like the tokens of a short Split
+ *
+ * @tparam T type of the elements
+ * @tparam N inline capacity
+ */
+template <typename T, size_t N>
+class small_vector
+{
+    static_assert(N > 0, "small_vector needs an inline capacity");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    small_vector() = default;
+    small_vector(std::initializer_list<T> init);
+
+    small_vector(const small_vector& other);
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    small_vector& operator=(const small_vector& other);
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    ~small_vector();
+
+    iterator begin() noexcept { return elements(); }
+    const_iterator begin() const noexcept { return elements(); }
+    iterator end() noexcept { return elements() + m_size; }
+    const_iterator end() const noexcept { return elements() + m_size; }
+
+    T* data() noexcept { return elements(); }
+    const T* data() const noexcept { return elements(); }
+
+    size_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+    size_t capacity() const noexcept { return m_capacity; }
+    static constexpr size_t inline_capacity() noexcept { return N; }
+
+    // true while the elements are in the inline buffer
+    bool is_inline() const noexcept { return m_data == inline_data(); }
+
+    T& operator[](size_t idx) { return element(idx); }
+    const T& operator[](size_t idx) const { return element(idx); }
+
+    T& front() { return element(0); }
+    const T& front() const { return element(0); }
+    T& back() { return element(m_size - 1); }
+    const T& back() const { return element(m_size - 1); }
+
+    void reserve(size_t capacity);
+
+    void push_back(const T& value);
+    void push_back(T&& value);
+
+    template <typename... ArgsT>
+    T& emplace_back(ArgsT&&... args);
+
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, T&& value);
+
+    void pop_back();
+    void clear();
+
+    bool operator==(const small_vector& other) const;
+
+private:
+    // only an address, there may be no element there to launder
+    T* inline_data() noexcept { return reinterpret_cast<T*>(m_inline); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(m_inline); }
+
+    // the elements, laundered as they may have been constructed in the inline buffer,
+    // an empty vector has none to launder so its storage is returned as it is
+    T* elements() noexcept { return m_size > 0 ? std::launder(m_data) : m_data; }
+    const T* elements() const noexcept { return m_size > 0 ? std::launder(m_data) : m_data; }
+
+    // a live element
+    T& element(size_t idx) { return *std::launder(m_data + idx); }
+    const T& element(size_t idx) const { return *std::launder(m_data + idx); }
+
+    // moves the elements to a heap buffer of at least min_capacity
+    void grow(size_t min_capacity);
+
+    void release();
+
+    void steal(small_vector&& other);
+
+private:
+    alignas(T) std::byte m_inline[sizeof(T) * N];
+    T* m_data = reinterpret_cast<T*>(m_inline);
+    size_t m_size = 0;
+    size_t m_capacity = N;
+};
+
+} // namespace Lud
+
+// IMPLEMENTATION
+namespace Lud {
+
+template <typename T, size_t N>
+constexpr static_vector<T, N>::static_vector(std::initializer_list<T> init)
+{
+    for (const auto& value : init)
+    {
+        push_back(value);
+    }
+}
+
+template <typename T, size_t N>
+constexpr void static_vector<T, N>::check_capacity() const
+{
+    if (m_size == N)
+    {
+        throw std::length_error("static_vector capacity exceeded");
+    }
+}
+
+template <typename T, size_t N>
+constexpr void static_vector<T, N>::push_back(const T& value)
+{
+    check_capacity();
+    m_data[m_size++] = value;
+}
+
+template <typename T, size_t N>
+constexpr void static_vector<T, N>::push_back(T&& value)
+{
+    check_capacity();
+    m_data[m_size++] = std::move(value);
+}
+
+template <typename T, size_t N>
+template <typename... ArgsT>
+constexpr T& static_vector<T, N>::emplace_back(ArgsT&&... args)
+{
+    check_capacity();
+    m_data[m_size] = T(std::forward<ArgsT>(args)...);
+    return m_data[m_size++];
+}
+
+template <typename T, size_t N>
+constexpr static_vector<T, N>::iterator static_vector<T, N>::insert(const_iterator pos, const T& value)
+{
+    return insert(pos, T(value));
+}
+
+template <typename T, size_t N>
+constexpr static_vector<T, N>::iterator static_vector<T, N>::insert(const_iterator pos, T&& value)
+{
+    check_capacity();
+    const auto idx = static_cast<size_t>(pos - begin());
+    std::move_backward(begin() + idx, end(), end() + 1);
+    m_data[idx] = std::move(value);
+    m_size++;
+    return begin() + idx;
+}
+
+template <typename T, size_t N>
+constexpr void static_vector<T, N>::pop_back()
+{
+    m_data[--m_size] = T();
+}
+
+template <typename T, size_t N>
+constexpr void static_vector<T, N>::clear()
+{
+    while (!empty())
+    {
+        pop_back();
+    }
+}
+
+template <typename T, size_t N>
+constexpr bool static_vector<T, N>::operator==(const static_vector& other) const
+{
+    return std::ranges::equal(*this, other);
+}
+
+template <typename T, size_t N>
+small_vector<T, N>::small_vector(std::initializer_list<T> init)
+{
+    reserve(init.size());
+    for (const auto& value : init)
+    {
+        push_back(value);
+    }
+}
+
+template <typename T, size_t N>
+small_vector<T, N>::small_vector(const small_vector& other)
+{
+    reserve(other.size());
+    std::uninitialized_copy(other.begin(), other.end(), m_data);
+    m_size = other.size();
+}
+
+template <typename T, size_t N>
+small_vector<T, N>::small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+{
+    steal(std::move(other));
+}
+
+template <typename T, size_t N>
+small_vector<T, N>& small_vector<T, N>::operator=(const small_vector& other)
+{
+    if (this != &other)
+    {
+        clear();
+        reserve(other.size());
+        std::uninitialized_copy(other.begin(), other.end(), m_data);
+        m_size = other.size();
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+small_vector<T, N>& small_vector<T, N>::operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+{
+    if (this != &other)
+    {
+        release();
+        steal(std::move(other));
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+small_vector<T, N>::~small_vector()
+{
+    release();
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::release()
+{
+    clear();
+    if (!is_inline())
+    {
+        std::allocator<T>().deallocate(m_data, m_capacity);
+        m_data = inline_data();
+        m_capacity = N;
+    }
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::steal(small_vector&& other)
+{
+    // this is empty and inline here
+    if (other.is_inline())
+    {
+        std::uninitialized_move(other.begin(), other.end(), m_data);
+        m_size = other.m_size;
+        other.clear();
+    }
+    else
+    {
+        m_data = std::exchange(other.m_data, other.inline_data());
+        m_size = std::exchange(other.m_size, 0);
+        m_capacity = std::exchange(other.m_capacity, N);
+    }
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::grow(size_t min_capacity)
+{
+    const size_t capacity = std::max(min_capacity, m_capacity * 2);
+    T* data = std::allocator<T>().allocate(capacity);
+    std::uninitialized_move(begin(), end(), data);
+    std::destroy(begin(), end());
+    if (!is_inline())
+    {
+        std::allocator<T>().deallocate(m_data, m_capacity);
+    }
+    m_data = data;
+    m_capacity = capacity;
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::reserve(size_t capacity)
+{
+    if (capacity > m_capacity)
+    {
+        grow(capacity);
+    }
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::push_back(const T& value)
+{
+    emplace_back(value);
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::push_back(T&& value)
+{
+    emplace_back(std::move(value));
+}
+
+template <typename T, size_t N>
+template <typename... ArgsT>
+T& small_vector<T, N>::emplace_back(ArgsT&&... args)
+{
+    if (m_size == m_capacity)
+    {
+        // args may refer to an element, so the value is made before the elements move
+        T value(std::forward<ArgsT>(args)...);
+        grow(m_size + 1);
+        std::construct_at(m_data + m_size, std::move(value));
+    }
+    else
+    {
+        std::construct_at(m_data + m_size, std::forward<ArgsT>(args)...);
+    }
+    return element(m_size++);
+}
+
+template <typename T, size_t N>
+small_vector<T, N>::iterator small_vector<T, N>::insert(const_iterator pos, const T& value)
+{
+    return insert(pos, T(value));
+}
+
+template <typename T, size_t N>
+small_vector<T, N>::iterator small_vector<T, N>::insert(const_iterator pos, T&& value)
+{
+    const auto idx = static_cast<size_t>(pos - begin());
+    if (idx == m_size)
+    {
+        emplace_back(std::move(value));
+        return begin() + idx;
+    }
+    emplace_back(std::move(back()));
+    std::move_backward(begin() + idx, end() - 2, end() - 1);
+    element(idx) = std::move(value);
+    return begin() + idx;
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::pop_back()
+{
+    std::destroy_at(&element(--m_size));
+}
+
+template <typename T, size_t N>
+void small_vector<T, N>::clear()
+{
+    std::destroy(begin(), end());
+    m_size = 0;
+}
+
+template <typename T, size_t N>
+bool small_vector<T, N>::operator==(const small_vector& other) const
+{
+    return std::ranges::equal(*this, other);
+}
+
+} // namespace Lud
+
+#endif //! LUD_CONTAINERS_HEADER
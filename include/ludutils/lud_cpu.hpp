@@ -0,0 +1,181 @@
+#ifndef LUD_CPU_HEADER
+#define LUD_CPU_HEADER
+
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LUD_CPU_X86 1
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+// marks a function as compiled for an instruction set above the baseline, MSVC needs nothing for intrinsics
+#if defined(LUD_CPU_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define LUD_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define LUD_TARGET(isa)
+#endif
+
+namespace Lud {
+
+/**
+ * @brief instruction sets the kernels can be dispatched on, only set when the os also saves the registers
+ */
+struct cpu_features
+{
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse42 = false;
+    bool avx2 = false;
+    bool avx512bw = false;
+    bool bmi2 = false;
+};
+
+/**
+ * @brief queries CPUID, all false on non x86 targets
+ */
+cpu_features DetectCpuFeatures();
+
+/**
+ * @brief features the kernels dispatch on, detected on first use
+ *        setting the environment variable LUD_FORCE_SCALAR to anything but "0" clears them all
+ *        so the scalar kernels can be benchmarked against the vector ones without rebuilding
+ */
+const cpu_features& CpuFeatures();
+
+/**
+ * @brief one implementation of a kernel per instruction set, entries left null are not available
+ *        select is meant to be called once and cached, for example in a function local static
+ *
+ * @tparam FnT function pointer type of the kernel
+ */
+template <typename FnT>
+struct dispatch_table
+{
+    FnT scalar = nullptr;
+    FnT sse2 = nullptr;
+    FnT ssse3 = nullptr;
+    FnT avx2 = nullptr;
+    FnT avx512bw = nullptr;
+
+    /**
+     * @brief best available entry the cpu supports, falls back to scalar
+     */
+    constexpr FnT select(const cpu_features& features) const;
+
+    FnT select() const { return select(CpuFeatures()); }
+};
+
+} // namespace Lud
+
+// IMPLEMENTATION
+namespace Lud {
+
+namespace detail {
+
+#if defined(LUD_CPU_X86)
+inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t (&regs)[4])
+{
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int out[4];
+    __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; i++)
+    {
+        regs[i] = static_cast<uint32_t>(out[i]);
+    }
+    #else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+}
+
+// register state the os saves on context switches, XCR0
+inline uint64_t xgetbv()
+{
+    #if defined(_MSC_VER) && !defined(__clang__)
+    return _xgetbv(0);
+    #else
+    uint32_t lo;
+    uint32_t hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+    #endif
+}
+#endif
+
+} // namespace detail
+
+inline cpu_features DetectCpuFeatures()
+{
+    cpu_features features;
+#if defined(LUD_CPU_X86)
+    uint32_t regs[4]{};
+    detail::cpuid(0, 0, regs);
+    const uint32_t max_leaf = regs[0];
+
+    detail::cpuid(1, 0, regs);
+    features.sse2 = (regs[3] >> 26) & 1;
+    features.ssse3 = (regs[2] >> 9) & 1;
+    features.sse42 = (regs[2] >> 20) & 1;
+    const bool osxsave = (regs[2] >> 27) & 1;
+    const bool avx = (regs[2] >> 28) & 1;
+
+    // xmm and ymm state for avx, plus opmask and both zmm halves for avx512
+    const uint64_t xcr0 = osxsave ? detail::xgetbv() : 0;
+    const bool os_avx = avx && (xcr0 & 0x06) == 0x06;
+    const bool os_avx512 = os_avx && (xcr0 & 0xE0) == 0xE0;
+
+    if (max_leaf >= 7)
+    {
+        detail::cpuid(7, 0, regs);
+        features.avx2 = os_avx && ((regs[1] >> 5) & 1);
+        features.bmi2 = (regs[1] >> 8) & 1;
+        const bool avx512f = (regs[1] >> 16) & 1;
+        features.avx512bw = os_avx512 && avx512f && ((regs[1] >> 30) & 1);
+    }
+#endif
+    return features;
+}
+
+inline const cpu_features& CpuFeatures()
+{
+    static const cpu_features features = [] {
+        const char* force_scalar = std::getenv("LUD_FORCE_SCALAR"); // NOLINT
+        if (force_scalar != nullptr && std::string_view(force_scalar) != "0")
+        {
+            return cpu_features{};
+        }
+        return DetectCpuFeatures();
+    }();
+    return features;
+}
+
+template <typename FnT>
+constexpr FnT dispatch_table<FnT>::select(const cpu_features& features) const
+{
+    if (avx512bw && features.avx512bw)
+    {
+        return avx512bw;
+    }
+    if (avx2 && features.avx2)
+    {
+        return avx2;
+    }
+    if (ssse3 && features.ssse3)
+    {
+        return ssse3;
+    }
+    if (sse2 && features.sse2)
+    {
+        return sse2;
+    }
+    return scalar;
+}
+
+} // namespace Lud
+
+#endif //! LUD_CPU_HEADER
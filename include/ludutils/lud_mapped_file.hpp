@@ -0,0 +1,300 @@
+#ifndef LUD_MAPPED_FILE_HEADER
+#define LUD_MAPPED_FILE_HEADER
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "lud_mem_stream.hpp"
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Lud {
+
+/**
+ * @brief how the pages of a mapping are going to be read, passed to madvise
+ *        hints are best effort, on windows only willneed does something
+ */
+enum class access_hint
+{
+    normal,
+    sequential,
+    random,
+    // start reading the pages in now
+    willneed,
+};
+
+/**
+ * @brief read only memory mapping of a whole file, pages are read in lazily as they are touched
+ *        so files bigger than memory can be read without copying them into the heap
+ *        failing to open or map the file throws std::system_error, an empty file maps to an empty span
+ *
+ * usage:
+ *     Lud::mapped_file file("replay.bin", Lud::access_hint::sequential);
+ *     std::span<const uint8_t> bytes = file.bytes();
+ */
+class mapped_file
+{
+public:
+    mapped_file() = default;
+    explicit mapped_file(const std::filesystem::path& path, access_hint hint = access_hint::normal);
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+
+    ~mapped_file();
+
+    /**
+     * @brief hint for the whole file or for size bytes from offset, the range is widened to whole pages
+     */
+    void advise(access_hint hint) const;
+    void advise(access_hint hint, size_t offset, size_t size) const;
+
+    std::span<const uint8_t> bytes() const { return {data(), m_size}; }
+    // the same bytes as text, to be used with lud_parse
+    std::string_view view() const { return {static_cast<const char*>(m_data), m_size}; }
+
+    const uint8_t* data() const { return static_cast<const uint8_t*>(m_data); }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    void close();
+
+private:
+    void* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+/**
+ * @brief std::istream over a mapped_file, reads are copies straight out of the mapping
+ */
+class mmap_istream : public std::istream
+{
+public:
+    // sequential lets the kernel read ahead aggressively
+    explicit mmap_istream(const std::filesystem::path& path, access_hint hint = access_hint::sequential);
+    explicit mmap_istream(mapped_file file);
+
+    const mapped_file& file() const { return m_file; }
+
+private:
+    mapped_file m_file;
+    view_streambuf<uint8_t> m_buffer;
+};
+
+} // namespace Lud
+
+// IMPLEMENTATION
+namespace Lud {
+
+namespace detail {
+
+#if defined(_WIN32)
+[[noreturn]] inline void throw_mapping_error(const char* what, const std::filesystem::path& path)
+{
+    throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), std::string(what) + " " + path.string());
+}
+#else
+[[noreturn]] inline void throw_mapping_error(const char* what, const std::filesystem::path& path)
+{
+    throw std::system_error(errno, std::generic_category(), std::string(what) + " " + path.string());
+}
+
+inline int madvise_flag(access_hint hint)
+{
+    switch (hint)
+    {
+    case access_hint::sequential:
+        return MADV_SEQUENTIAL;
+    case access_hint::random:
+        return MADV_RANDOM;
+    case access_hint::willneed:
+        return MADV_WILLNEED;
+    default:
+        return MADV_NORMAL;
+    }
+}
+#endif
+
+} // namespace detail
+
+#if defined(_WIN32)
+inline mapped_file::mapped_file(const std::filesystem::path& path, access_hint hint)
+{
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        detail::throw_mapping_error("could not open", path);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        detail::throw_mapping_error("could not get the size of", path);
+    }
+    if (size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return;
+    }
+    // the view keeps the mapping and the file alive, both handles can go once it exists
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        detail::throw_mapping_error("could not map", path);
+    }
+    m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (m_data == nullptr)
+    {
+        detail::throw_mapping_error("could not map", path);
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+    advise(hint);
+}
+
+inline void mapped_file::advise(access_hint hint, size_t offset, size_t size) const
+{
+    if (hint != access_hint::willneed || offset >= m_size)
+    {
+        return;
+    }
+    WIN32_MEMORY_RANGE_ENTRY range{static_cast<uint8_t*>(m_data) + offset, std::min(size, m_size - offset)};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+inline void mapped_file::close()
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+#else
+inline mapped_file::mapped_file(const std::filesystem::path& path, access_hint hint)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        detail::throw_mapping_error("could not open", path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) == -1)
+    {
+        const int error = errno;
+        ::close(fd);
+        errno = error;
+        detail::throw_mapping_error("could not get the size of", path);
+    }
+    if (info.st_size == 0)
+    {
+        ::close(fd);
+        return;
+    }
+    const auto size = static_cast<size_t>(info.st_size);
+    // the mapping keeps its own reference to the file
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        errno = error;
+        detail::throw_mapping_error("could not map", path);
+    }
+    m_data = data;
+    m_size = size;
+    advise(hint);
+}
+
+inline void mapped_file::advise(access_hint hint, size_t offset, size_t size) const
+{
+    if (offset >= m_size)
+    {
+        return;
+    }
+    // madvise wants a page aligned start
+    const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t begin = offset / page * page;
+    const size_t end = size > m_size - offset ? m_size : offset + size;
+    ::madvise(static_cast<uint8_t*>(m_data) + begin, end - begin, detail::madvise_flag(hint));
+}
+
+inline void mapped_file::close()
+{
+    if (m_data != nullptr)
+    {
+        ::munmap(m_data, m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+#endif
+
+inline mapped_file::mapped_file(mapped_file&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+{
+}
+
+inline mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+inline mapped_file::~mapped_file()
+{
+    close();
+}
+
+inline void mapped_file::advise(access_hint hint) const
+{
+    advise(hint, 0, m_size);
+}
+
+inline mmap_istream::mmap_istream(const std::filesystem::path& path, access_hint hint)
+    : mmap_istream(mapped_file(path, hint))
+{
+}
+
+inline mmap_istream::mmap_istream(mapped_file file)
+    : std::istream(&m_buffer)
+    , m_file(std::move(file))
+    , m_buffer(m_file.bytes())
+{
+}
+
+} // namespace Lud
+
+#endif //! LUD_MAPPED_FILE_HEADER
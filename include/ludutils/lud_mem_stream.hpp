@@ -3,10 +3,19 @@
 #include <ios>
 #include <istream>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <span>
+#include <stdexcept>
 #include <streambuf>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Lud {
@@ -16,6 +25,12 @@ concept ByteType = requires(T param) {
     requires sizeof param == 1;
 };
 
+// types whose byte order can be swapped as a whole
+template <typename T>
+concept ByteSwappable = requires {
+    requires std::is_arithmetic_v<T> || std::is_enum_v<T>;
+};
+
 // C++ standard does not provide char_traits specification for
 // uint8_t and recommends just casting when using binary data
 template <ByteType T = uint8_t>
@@ -32,10 +47,20 @@ public:
     view_streambuf(std::span<const T> data);
     view_streambuf() = default;
 
+    /**
+     * @brief the next n bytes, fewer at the end of the view, without copying them
+     *        the get position moves past the bytes returned
+     */
+    std::span<const T> read_view(size_t n);
+
 protected:
+    // seeking outside of the view fails like on any other stream, returning pos_type(off_type(-1))
     PosT seekoff(OffT off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
     PosT seekpos(PosT pos, std::ios_base::openmode which) override;
 
+    std::streamsize showmanyc() override;
+    IntT underflow() override;
+
     std::streamsize xsgetn(CharT* s, std::streamsize count) override;
 };
 
@@ -47,11 +72,88 @@ public:
 
     memory_istream() = default;
 
+    using std::istream::read;
+
+    /**
+     * @brief the next n bytes as a view into the data, nothing is copied
+     *        like read, fewer bytes at the end of the data set eofbit and failbit
+     */
+    std::span<const T> read_view(size_t n);
+
+    /**
+     * @brief reads out.size() values of U, or nothing setting eofbit and failbit when there are not enough bytes left
+     *
+     * @param order byte order of the data, values are swapped when it is not the native one
+     */
+    template <typename U, size_t ExtentT>
+        requires std::is_trivially_copyable_v<U>
+    memory_istream& read_into(std::span<U, ExtentT> out);
+
+    template <ByteSwappable U, size_t ExtentT>
+    memory_istream& read_into(std::span<U, ExtentT> out, std::endian order);
+
+    /**
+     * @brief reads one U like read_into, a value initialized U is returned when it fails
+     */
+    template <typename U>
+        requires std::is_trivially_copyable_v<U>
+    U read();
+
+    template <ByteSwappable U>
+    U read(std::endian order);
+
 private:
 
     view_streambuf<T> m_buffer;
 };
 
+/**
+ * @brief how a vector written through a stream or a byte_writer gets its new capacity when it runs out
+ *
+ * usage:
+ *     Lud::growth_policy{.factor = 2.0}
+ *     Lud::growth_policy{.chunk = 1 << 20}     // a fixed 1 MiB at a time
+ *     Lud::growth_policy{.round_to = 4096}     // whole pages
+ */
+struct growth_policy
+{
+    // the capacity is multiplied by this
+    double factor = 1.5;
+    // when non zero the capacity grows by this many elements instead of by factor
+    size_t chunk = 0;
+    // the new capacity is rounded up to a multiple of this
+    size_t round_to = 1;
+
+    // never less than needed
+    constexpr size_t next_capacity(size_t capacity, size_t needed) const;
+};
+
+namespace detail {
+// how far past what a write needs the size of a vector is extended, the room there is value initialized once
+// instead of on every write, it doubles while writing and starts over small after each flush, so a flush per record
+// only zeroes a little of the capacity again while long writes rarely need to come back
+class write_window
+{
+public:
+    // resizes vec to hold at least needed elements, never past its capacity unless it has to grow
+    template <typename T>
+    void extend(std::vector<T>& vec, size_t needed, const growth_policy& growth);
+
+    void reset() { m_size = min_size; }
+
+private:
+    static constexpr size_t min_size = 256;
+    static constexpr size_t max_size = size_t{1} << 20;
+
+    size_t m_size = min_size;
+};
+} // namespace detail
+
+/**
+ * @brief streambuf writing into and reading from a vector
+ *        the put area runs into the capacity of the vector, what was written is only published to the vector's size()
+ *        on sync, on seeks and on destruction, syncing never reallocates, shrink_to_fit() has to be asked for
+ */
 template <ByteType T = uint8_t>
 class vector_wrap_streambuf : public std::streambuf
 {
@@ -63,10 +165,17 @@ public:
     using OffT = Base::off_type;
     using PosT = Base::pos_type;
 
-    vector_wrap_streambuf(std::vector<T>& buffer, std::ios_base::openmode);
+    vector_wrap_streambuf(std::vector<T>& buffer, std::ios_base::openmode, const growth_policy& growth = {});
     ~vector_wrap_streambuf();
 
+    /**
+     * @brief publishes what was written and gives the unused capacity back
+     */
+    void shrink_to_fit();
+
 protected:
+    std::streamsize showmanyc() override;
+    IntT underflow() override;
 
     IntT overflow(IntT ch = TraitsT::eof()) override;
 
@@ -78,20 +187,34 @@ protected:
     PosT seekpos(PosT pos, std::ios_base::openmode which) override;
 
 private:
-    constexpr void set_pg_area_pointers();
+    char* storage() { return reinterpret_cast<char*>(m_buffer.data()); }
+
+    // points both areas into the vector again, the offsets are from pbase and eback
+    constexpr void set_pg_area_pointers(OffT put_offset, OffT get_offset);
 
-    constexpr void increase_capacity(size_t sz);
+    // end of what was written, published or not
+    constexpr size_t written_size();
 
-    constexpr PosT seekoff_get_area(OffT off, std::ios_base::seekdir dir, std::ios_base::openmode which);
-    constexpr PosT seekoff_put_area(OffT off, std::ios_base::seekdir dir, std::ios_base::openmode which);
+    // makes what was written the size of the vector, only ever shrinks it so it never reallocates
+    constexpr void commit();
 
-    constexpr size_t get_put_area_size() const;
-    constexpr size_t get_get_area_size() const;
+    // room in the put area for n more chars, false if it could not be allocated
+    constexpr bool make_room(size_t n);
+
+    // pbump only takes an int, bigger offsets are applied in steps
+    constexpr void pbump_wide(OffT off);
+
+    constexpr PosT seekoff_get_area(OffT off, std::ios_base::seekdir dir);
+    constexpr PosT seekoff_put_area(OffT off, std::ios_base::seekdir dir);
 
 private:
     size_t m_original_size = 0;
     std::vector<T>& m_buffer;
     std::ios_base::openmode m_openmode;
+    growth_policy m_growth;
+    // elements of the vector that hold written data, the rest up to its size() is room for the put area
+    size_t m_committed = 0;
+    detail::write_window m_put_window;
 };
 
 template <ByteType T = uint8_t>
@@ -108,12 +231,229 @@ template <ByteType T = uint8_t>
 class vector_ostream : public std::ostream
 {
 public:
-    vector_ostream(std::vector<T>& vec, std::ios_base::openmode = std::ios::out);
+    vector_ostream(std::vector<T>& vec, std::ios_base::openmode = std::ios::out, const growth_policy& growth = {});
+
+    // flushes and gives the unused capacity of the vector back
+    void shrink_to_fit() { m_sbuf.shrink_to_fit(); }
 
 private:
     vector_wrap_streambuf<T> m_sbuf;
 };
 
+/**
+ * @brief what a byte_reader does when a read goes past the end of its data
+ */
+enum class bounds_check
+{
+    // throws std::out_of_range
+    exception,
+    // reads nothing and returns value initialized values, failed() tells afterwards like a stream's failbit
+    flag,
+    // no checks, the caller makes sure with remaining()
+    none,
+};
+
+/**
+ * @brief cursor over a span, a lighter memory_istream for small binary fields
+ *        every call is non virtual and can be inlined
+ *
+ * @tparam CheckT what happens on reads past the end, fixed at compile time so none costs nothing
+ */
+template <ByteType T = uint8_t, bounds_check CheckT = bounds_check::exception>
+class byte_reader
+{
+public:
+    byte_reader() = default;
+    explicit byte_reader(std::span<const T> data);
+
+    T get();
+
+    template <typename U>
+        requires std::is_trivially_copyable_v<U>
+    U read();
+
+    // values are byte swapped when order is not the native one
+    template <ByteSwappable U>
+    U read(std::endian order);
+
+    template <typename U, size_t ExtentT>
+        requires std::is_trivially_copyable_v<U>
+    void read_into(std::span<U, ExtentT> out);
+
+    // the next n bytes without copying them
+    std::span<const T> read_view(size_t n);
+
+    void skip(size_t n);
+
+    // seeking forward is checked like a read
+    void seek(size_t pos);
+
+    size_t position() const { return m_pos; }
+    size_t remaining() const { return m_data.size() - m_pos; }
+    bool at_end() const { return m_pos == m_data.size(); }
+
+    bool failed() const { return m_failed; }
+    void clear() { m_failed = false; }
+
+    std::span<const T> data() const { return m_data; }
+
+    // the bytes left, for the std APIs
+    memory_istream<T> istream() const { return memory_istream<T>(m_data.subspan(m_pos)); }
+
+private:
+    // true when n more bytes can be read, otherwise throws or sets the flag as CheckT says
+    bool check(size_t n);
+
+private:
+    std::span<const T> m_data;
+    size_t m_pos = 0;
+    bool m_failed = false;
+};
+
+/**
+ * @brief cursor writing into a vector, a lighter vector_ostream for small binary fields
+ *        every call is non virtual and can be inlined, the vector grows like under vector_wrap_streambuf
+ *        writing starts at the end of the vector, seek() goes back to patch what was written
+ *        while writing the vector runs a little past the bytes written, so most writes are just a copy,
+ *        flush() or the destructor cut it back to the bytes written
+ */
+template <ByteType T = uint8_t>
+class byte_writer
+{
+public:
+    explicit byte_writer(std::vector<T>& buffer, const growth_policy& growth = {});
+
+    byte_writer(const byte_writer&) = delete;
+    byte_writer& operator=(const byte_writer&) = delete;
+    byte_writer(byte_writer&&) = delete;
+    byte_writer& operator=(byte_writer&&) = delete;
+
+    ~byte_writer();
+
+    void put(T byte);
+
+    template <typename U>
+        requires std::is_trivially_copyable_v<U>
+    void write(const U& value);
+
+    // values are byte swapped when order is not the native one
+    template <ByteSwappable U>
+    void write(U value, std::endian order);
+
+    template <typename U, size_t ExtentT>
+        requires std::is_trivially_copyable_v<U>
+    void write_span(std::span<U, ExtentT> values);
+
+    // position of the next write
+    size_t position() const { return m_pos; }
+
+    // bytes in the vector, the ones there before the writer included
+    size_t size() const { return m_size; }
+
+    // throws std::out_of_range past size()
+    void seek(size_t pos);
+
+    // room for n more bytes after size()
+    void reserve(size_t n) { m_buffer.reserve(m_size + n); }
+
+    // cuts the vector back to size()
+    void flush();
+
+    // the vector, flushed
+    std::vector<T>& buffer();
+
+    // the vector as a stream, for the std APIs, flushed first
+    vector_istream<T> istream();
+
+    template <bounds_check CheckT = bounds_check::exception>
+    byte_reader<T, CheckT> reader() const { return byte_reader<T, CheckT>(std::span<const T>(m_buffer.data(), m_size)); }
+
+private:
+    // makes room for n bytes at the cursor and moves past them, returns where they go
+    T* claim(size_t n);
+
+private:
+    std::vector<T>& m_buffer;
+    growth_policy m_growth;
+    detail::write_window m_window;
+    size_t m_pos;
+    // end of what was written, the vector may go a little past it
+    size_t m_size;
+};
+
+namespace detail {
+
+/**
+ * @brief pointer off bytes away from the origin picked by dir, nullptr if it falls outside of [begin, end]
+ *        offsets are compared as 64 bit values, nothing gets truncated to an int
+ */
+inline char* seek_target(char* begin, char* current, char* end, std::streamoff off, std::ios_base::seekdir dir)
+{
+    char* origin = nullptr;
+    switch (dir)
+    {
+    case std::ios::beg:
+        origin = begin;
+        break;
+    case std::ios::cur:
+        origin = current;
+        break;
+    case std::ios::end:
+        origin = end;
+        break;
+    default:
+        return nullptr;
+    }
+    if (off < begin - origin || off > end - origin)
+    {
+        return nullptr;
+    }
+    return origin + off;
+}
+
+template <ByteSwappable U>
+U byteswap(U value)
+{
+    if constexpr (std::is_enum_v<U>)
+    {
+        return static_cast<U>(std::byteswap(std::to_underlying(value)));
+    }
+    else if constexpr (std::is_integral_v<U>)
+    {
+        return std::byteswap(value);
+    }
+    else
+    {
+        auto bytes = std::bit_cast<std::array<std::byte, sizeof(U)>>(value);
+        std::ranges::reverse(bytes);
+        return std::bit_cast<U>(bytes);
+    }
+}
+
+template <typename T>
+void write_window::extend(std::vector<T>& vec, size_t needed, const growth_policy& growth)
+{
+    if (needed > vec.capacity())
+    {
+        vec.reserve(growth.next_capacity(vec.capacity(), needed));
+    }
+    vec.resize(std::min(vec.capacity(), std::max(needed, vec.size() + m_size)));
+    m_size = std::min(m_size * 2, max_size);
+}
+
+} // namespace detail
+
+constexpr size_t growth_policy::next_capacity(size_t capacity, size_t needed) const
+{
+    size_t next = chunk != 0 ? capacity + chunk : static_cast<size_t>(static_cast<double>(capacity) * factor);
+    next = std::max(next, needed);
+    if (round_to > 1)
+    {
+        next = (next + round_to - 1) / round_to * round_to;
+    }
+    return next;
+}
+
 template <ByteType T>
 view_streambuf<T>::view_streambuf(std::span<const T> data)
 {
@@ -124,19 +464,17 @@ view_streambuf<T>::view_streambuf(std::span<const T> data)
 template <ByteType T>
 view_streambuf<T>::PosT view_streambuf<T>::seekoff(OffT off, std::ios_base::seekdir dir, std::ios_base::openmode which)
 {
-    if (dir == std::ios_base::cur)
-    {
-        Base::gbump(static_cast<int>(off));
-    }
-    else if (dir == std::ios_base::end)
+    char* target = nullptr;
+    if (which & std::ios::in)
     {
-        Base::setg(Base::eback(), Base::egptr() + off, Base::egptr());
+        target = detail::seek_target(Base::eback(), Base::gptr(), Base::egptr(), off, dir);
     }
-    else if (dir == std::ios_base::beg)
+    if (target == nullptr)
     {
-        Base::setg(Base::eback(), Base::eback() + off, Base::egptr());
+        return PosT(OffT(-1));
     }
-    return Base::gptr() - Base::eback();
+    Base::setg(Base::eback(), target, Base::egptr());
+    return PosT(OffT(target - Base::eback()));
 }
 
 template <ByteType T>
@@ -145,21 +483,46 @@ view_streambuf<T>::PosT view_streambuf<T>::seekpos(PosT pos, std::ios_base::open
     return seekoff(pos, std::ios::beg, which);
 }
 
+template <ByteType T>
+std::streamsize view_streambuf<T>::showmanyc()
+{
+    const std::streamsize avail = Base::egptr() - Base::gptr();
+    return avail > 0 ? avail : -1;
+}
+
+template <ByteType T>
+view_streambuf<T>::IntT view_streambuf<T>::underflow()
+{
+    if (Base::gptr() == Base::egptr())
+    {
+        return TraitsT::eof();
+    }
+    return TraitsT::to_int_type(*Base::gptr());
+}
+
 template <ByteType T>
 std::streamsize view_streambuf<T>::xsgetn(CharT* s, std::streamsize count)
 {
-    std::streamsize avail = Base::egptr() - Base::gptr();
-    auto to_copy = avail < count ? avail : count;
-    if (avail == 0)
+    const std::streamsize to_copy = std::min<std::streamsize>(Base::egptr() - Base::gptr(), count);
+    if (to_copy <= 0)
     {
         return 0;
     }
     TraitsT::copy(s, Base::gptr(), to_copy);
-    Base::gbump(to_copy);
+    Base::setg(Base::eback(), Base::gptr() + to_copy, Base::egptr());
 
     return to_copy;
 }
 
+template <ByteType T>
+std::span<const T> view_streambuf<T>::read_view(size_t n)
+{
+    const size_t count = std::min(n, static_cast<size_t>(Base::egptr() - Base::gptr()));
+    const auto* data = reinterpret_cast<const T*>(Base::gptr());
+    Base::setg(Base::eback(), Base::gptr() + count, Base::egptr());
+    return {data, count};
+}
+
 template <ByteType T>
 memory_istream<T>::memory_istream(std::span<const T> data)
     : std::istream(&m_buffer)
@@ -168,41 +531,96 @@ memory_istream<T>::memory_istream(std::span<const T> data)
 }
 
 template <ByteType T>
-vector_wrap_streambuf<T>::vector_wrap_streambuf(std::vector<T>& buffer, std::ios_base::openmode mode)
-    : m_buffer(buffer)
-    , m_openmode(mode)
+std::span<const T> memory_istream<T>::read_view(size_t n)
 {
-    char* cs = reinterpret_cast<char*>(m_buffer.data());
+    // what a sentry would check, without its out of line call since there is nothing to flush or skip
+    if (!good())
+    {
+        setstate(std::ios::failbit);
+        return {};
+    }
+    const auto view = m_buffer.read_view(n);
+    if (view.size() < n)
+    {
+        setstate(std::ios::eofbit | std::ios::failbit);
+    }
+    return view;
+}
 
-    if (mode & std::ios::out)
+template <ByteType T>
+template <typename U, size_t ExtentT>
+    requires std::is_trivially_copyable_v<U>
+memory_istream<T>& memory_istream<T>::read_into(std::span<U, ExtentT> out)
+{
+    if (!good())
     {
-        if (mode & std::ios::trunc)
-        {
-            m_buffer.clear();
-        }
-        else if (mode & std::ios::app)
-        {
-            m_original_size = m_buffer.size();
-            Base::setp(cs + m_original_size, cs + m_original_size);
-        }
-        else
-        {
-            Base::setp(cs, cs + m_buffer.size());
-        }
-        if (mode & std::ios::ate)
-        {
-            Base::pbump(m_buffer.size());
-        }
+        setstate(std::ios::failbit);
+        return *this;
+    }
+    if (out.empty())
+    {
+        return *this;
     }
-    if (mode & std::ios::in)
+    if (m_buffer.in_avail() < static_cast<std::streamsize>(out.size_bytes()))
     {
-        Base::setg(cs, cs, cs + m_buffer.size());
+        setstate(std::ios::eofbit | std::ios::failbit);
+        return *this;
+    }
+    std::memcpy(out.data(), m_buffer.read_view(out.size_bytes()).data(), out.size_bytes());
+    return *this;
+}
 
-        if (mode & std::ios::ate)
+template <ByteType T>
+template <ByteSwappable U, size_t ExtentT>
+memory_istream<T>& memory_istream<T>::read_into(std::span<U, ExtentT> out, std::endian order)
+{
+    read_into(out);
+    if (order != std::endian::native && !fail())
+    {
+        for (U& value : out)
         {
-            Base::gbump(m_buffer.size());
+            value = detail::byteswap(value);
         }
     }
+    return *this;
+}
+
+template <ByteType T>
+template <typename U>
+    requires std::is_trivially_copyable_v<U>
+U memory_istream<T>::read()
+{
+    U value{};
+    read_into(std::span(&value, 1));
+    return value;
+}
+
+template <ByteType T>
+template <ByteSwappable U>
+U memory_istream<T>::read(std::endian order)
+{
+    U value{};
+    read_into(std::span(&value, 1), order);
+    return value;
+}
+
+template <ByteType T>
+vector_wrap_streambuf<T>::vector_wrap_streambuf(std::vector<T>& buffer, std::ios_base::openmode mode, const growth_policy& growth)
+    : m_buffer(buffer)
+    , m_openmode(mode)
+    , m_growth(growth)
+{
+    if ((mode & std::ios::out) && (mode & std::ios::trunc))
+    {
+        m_buffer.clear();
+    }
+    m_committed = m_buffer.size();
+    if (mode & std::ios::app)
+    {
+        m_original_size = m_committed;
+    }
+    const bool ate = static_cast<bool>(mode & std::ios::ate);
+    set_pg_area_pointers(ate ? m_committed - m_original_size : 0, ate ? m_committed : 0);
 }
 
 template <Lud::ByteType T>
@@ -212,123 +630,169 @@ vector_wrap_streambuf<T>::~vector_wrap_streambuf()
 }
 
 template <ByteType T>
-constexpr void vector_wrap_streambuf<T>::set_pg_area_pointers()
+void vector_wrap_streambuf<T>::shrink_to_fit()
 {
-    char* cs = reinterpret_cast<char*>(m_buffer.data());
+    commit();
+    const OffT put_offset = Base::pptr() - Base::pbase();
+    const OffT get_offset = Base::gptr() - Base::eback();
+    m_buffer.shrink_to_fit();
+    set_pg_area_pointers(put_offset, get_offset);
+}
+
+template <ByteType T>
+constexpr void vector_wrap_streambuf<T>::set_pg_area_pointers(OffT put_offset, OffT get_offset)
+{
+    char* cs = storage();
 
-    // can't use m_buffer::size in case of append mode since append mode should not allow repositioning
-    // pointers before original eof
     if (m_openmode & std::ios::out)
     {
-        const ptrdiff_t p_dist = Base::pptr() - Base::pbase();
-        if (m_openmode & std::ios::app)
-        {
-            const size_t avail_size = m_buffer.size() - m_original_size;
-            Base::setp(cs + m_original_size, cs + avail_size);
-        }
-        else
-        {
-            Base::setp(cs, cs + m_buffer.size());
-        }
-
-        Base::pbump(p_dist);
+        // append mode never lets the put pointer go before the original end
+        const size_t put_begin = m_openmode & std::ios::app ? m_original_size : 0;
+        Base::setp(cs + put_begin, cs + m_buffer.size());
+        pbump_wide(put_offset);
     }
     if (m_openmode & std::ios::in)
     {
-        const ptrdiff_t g_dist = Base::gptr() - Base::eback();
+        Base::setg(cs, cs + get_offset, cs + m_committed);
+    }
+}
 
-        Base::setg(cs, cs + g_dist, cs + m_buffer.size());
+template <ByteType T>
+constexpr size_t vector_wrap_streambuf<T>::written_size()
+{
+    if (!(m_openmode & std::ios::out))
+    {
+        return m_committed;
     }
+    return std::max(m_committed, static_cast<size_t>(Base::pptr() - storage()));
 }
 
 template <ByteType T>
-constexpr void vector_wrap_streambuf<T>::increase_capacity(size_t sz)
+constexpr void vector_wrap_streambuf<T>::commit()
 {
-    // this is called in xsputn and overflow
-    // so in order to reduce reallocations we will be copying
-    // std::vector approach and doubling size when we are out of room
-    // if there is enough room we will do nothing
-    if (m_buffer.size() + sz >= m_buffer.capacity())
+    if (!(m_openmode & std::ios::out))
     {
-        std::size_t next_size = std::max(
-            m_buffer.size() + sz,
-            static_cast<size_t>(m_buffer.size() * 1.5)
-        );
-        m_buffer.reserve(next_size);
+        return;
     }
-    m_buffer.resize(m_buffer.size() + sz);
-    set_pg_area_pointers();
+    const OffT put_offset = Base::pptr() - Base::pbase();
+    const OffT get_offset = Base::gptr() - Base::eback();
+    m_committed = written_size();
+    m_buffer.resize(m_committed);
+    m_put_window.reset();
+    set_pg_area_pointers(put_offset, get_offset);
 }
 
 template <ByteType T>
-std::streamsize vector_wrap_streambuf<T>::xsputn(const CharT* s, std::streamsize count)
+constexpr bool vector_wrap_streambuf<T>::make_room(size_t n)
 {
+    const OffT put_offset = Base::pptr() - Base::pbase();
+    const OffT get_offset = Base::gptr() - Base::eback();
+    const size_t needed = static_cast<size_t>(Base::pptr() - storage()) + n;
     try
     {
-        increase_capacity(count);
+        m_put_window.extend(m_buffer, needed, m_growth);
     }
-    catch (const std::bad_alloc& e)
+    catch (const std::bad_alloc&)
     {
-        // feels icky, but if increase_capacity fails Base::xsptun() should end up calling overflow
-        // this probably has a shit ton of errors, should be tested
-        ;
+        return false;
     }
+    set_pg_area_pointers(put_offset, get_offset);
+    return true;
+}
 
-    std::streamsize written = Base::xsputn(s, count);
-    Base::setg(Base::eback(), Base::gptr(), Base::pptr());
+template <ByteType T>
+constexpr void vector_wrap_streambuf<T>::pbump_wide(OffT off)
+{
+    constexpr OffT step = std::numeric_limits<int>::max();
+    for (; off > step; off -= step)
+    {
+        Base::pbump(static_cast<int>(step));
+    }
+    for (; off < -step; off += step)
+    {
+        Base::pbump(static_cast<int>(-step));
+    }
+    Base::pbump(static_cast<int>(off));
+}
 
-    return written;
+template <ByteType T>
+std::streamsize vector_wrap_streambuf<T>::showmanyc()
+{
+    if (TraitsT::eq_int_type(underflow(), TraitsT::eof()))
+    {
+        return -1;
+    }
+    return Base::egptr() - Base::gptr();
 }
 
-// https://gist.github.com/stephanlachnit/272e5eb82c0e2a1cccd55af5d6b73e2b
 template <ByteType T>
-vector_wrap_streambuf<T>::IntT vector_wrap_streambuf<T>::overflow(IntT ch)
+vector_wrap_streambuf<T>::IntT vector_wrap_streambuf<T>::underflow()
 {
-    try
+    if (!(m_openmode & std::ios::in))
     {
-        increase_capacity(sizeof(CharT));
+        return TraitsT::eof();
     }
-    catch (const std::bad_alloc& e)
+    // what was written since the last commit is readable without publishing it
+    m_committed = written_size();
+    Base::setg(Base::eback(), Base::gptr(), storage() + m_committed);
+    if (Base::gptr() == Base::egptr())
     {
         return TraitsT::eof();
     }
+    return TraitsT::to_int_type(*Base::gptr());
+}
 
-    if (!TraitsT::eq_int_type(ch, TraitsT::eof()))
+template <ByteType T>
+std::streamsize vector_wrap_streambuf<T>::xsputn(const CharT* s, std::streamsize count)
+{
+    if (count <= 0 || !(m_openmode & std::ios::out))
     {
-        // CharT ch_char = TraitsT::to_CharT(ch);
-        // TraitsT::copy(pptr(), &ch_char, 1);
-        // https://eel.is/c++draft/streambuf.virtuals#streambuf.virt.put-4.3
-        // setp(pptr(), epptr());
-        size_t pos = pptr() - pbase();
-        if (m_openmode & std::ios::app)
-        {
-            pos += m_original_size;
-        }
-        m_buffer[pos] = static_cast<T>(ch);
-        pbump(sizeof(CharT));
+        return 0;
+    }
+    if (Base::epptr() - Base::pptr() < count && !make_room(static_cast<size_t>(count)))
+    {
+        return 0;
     }
-    return TraitsT::not_eof(ch);
+    TraitsT::copy(Base::pptr(), s, static_cast<size_t>(count));
+    pbump_wide(count);
+    return count;
 }
 
 template <ByteType T>
-int vector_wrap_streambuf<T>::sync()
+vector_wrap_streambuf<T>::IntT vector_wrap_streambuf<T>::overflow(IntT ch)
 {
-    m_buffer.shrink_to_fit();
-    set_pg_area_pointers();
+    if (TraitsT::eq_int_type(ch, TraitsT::eof()))
+    {
+        return TraitsT::not_eof(ch);
+    }
+    if (!(m_openmode & std::ios::out) || (Base::pptr() == Base::epptr() && !make_room(1)))
+    {
+        return TraitsT::eof();
+    }
+    *Base::pptr() = TraitsT::to_char_type(ch);
+    Base::pbump(1);
+    return ch;
+}
 
+template <ByteType T>
+int vector_wrap_streambuf<T>::sync()
+{
+    commit();
     return 0;
 }
 
 template <ByteType T>
 vector_wrap_streambuf<T>::PosT vector_wrap_streambuf<T>::seekoff(OffT off, std::ios_base::seekdir dir, std::ios_base::openmode which)
 {
+    // positions are within what was written, so it is published first
+    commit();
     if (which & std::ios::in)
     {
-        return seekoff_get_area(off, dir, which);
+        return seekoff_get_area(off, dir);
     }
     if (which & std::ios::out)
     {
-        return seekoff_put_area(off, dir, which);
+        return seekoff_put_area(off, dir);
     }
     throw std::invalid_argument("which must be either std::ios::in or std::ios::out");
 }
@@ -340,107 +804,240 @@ vector_wrap_streambuf<T>::PosT vector_wrap_streambuf<T>::seekpos(PosT pos, std::
 }
 
 template <ByteType T>
-constexpr vector_wrap_streambuf<T>::PosT vector_wrap_streambuf<T>::seekoff_get_area(OffT off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+constexpr vector_wrap_streambuf<T>::PosT vector_wrap_streambuf<T>::seekoff_get_area(OffT off, std::ios_base::seekdir dir)
 {
-    switch (dir)
+    char* target = detail::seek_target(Base::eback(), Base::gptr(), Base::egptr(), off, dir);
+    if (target == nullptr)
     {
-    case std::ios::cur:
+        throw std::range_error("get ptr offset out of bounds");
+    }
+    Base::setg(Base::eback(), target, Base::egptr());
+    return PosT(OffT(target - Base::eback()));
+}
+
+template <ByteType T>
+constexpr vector_wrap_streambuf<T>::PosT vector_wrap_streambuf<T>::seekoff_put_area(OffT off, std::ios_base::seekdir dir)
+{
+    char* target = detail::seek_target(Base::pbase(), Base::pptr(), Base::epptr(), off, dir);
+    if (target == nullptr)
     {
-        if (gptr() + off > egptr())
-        {
-            throw std::range_error("get ptr offset out of bounds");
-        }
-        Base::gbump(static_cast<int>(off));
-        break;
+        throw std::range_error("put ptr offset out of range");
     }
-    case std::ios::end:
+    Base::setp(Base::pbase(), Base::epptr());
+    pbump_wide(target - Base::pbase());
+    return PosT(OffT(target - Base::pbase()));
+}
+
+template <ByteType T>
+vector_istream<T>::vector_istream(std::vector<T>& vec, std::ios_base::openmode mode)
+    : std::istream(&m_sbuf)
+    , m_sbuf(vec, mode | std::ios::in)
+{
+    if (mode & std::ios_base::out)
     {
-        if (off > 0 || static_cast<size_t>(-off) > get_get_area_size())
-        {
-            throw std::range_error("get ptr offset out of bounds");
-        }
-        Base::setg(Base::eback(), Base::egptr() + off, Base::egptr());
-        break;
+        throw std::runtime_error("invalid openmode");
     }
-    case std::ios::beg:
+}
+
+template <ByteType T>
+vector_ostream<T>::vector_ostream(std::vector<T>& vec, std::ios_base::openmode mode, const growth_policy& growth)
+    : std::ostream(&m_sbuf)
+    , m_sbuf(vec, mode | std::ios::out, growth)
+{
+    if (mode & std::ios_base::in)
     {
-        if (off < 0 || static_cast<size_t>(off) > get_get_area_size())
+        throw std::runtime_error("invalid openmode");
+    }
+}
+
+template <ByteType T, bounds_check CheckT>
+byte_reader<T, CheckT>::byte_reader(std::span<const T> data)
+    : m_data(data)
+{
+}
+
+template <ByteType T, bounds_check CheckT>
+bool byte_reader<T, CheckT>::check(size_t n)
+{
+    if constexpr (CheckT == bounds_check::exception)
+    {
+        if (n > remaining())
         {
-            throw std::range_error("get ptr offset out of bounds");
+            throw std::out_of_range("byte_reader: read past the end of the data");
         }
-        Base::setg(Base::eback(), Base::eback() + off, Base::egptr());
-        break;
     }
-    default:
-        break;
+    else if constexpr (CheckT == bounds_check::flag)
+    {
+        // sticky, once a read fails the ones after it do too
+        m_failed = m_failed || n > remaining();
+        return !m_failed;
     }
-    return Base::gptr() - Base::eback();
+    return true;
 }
 
-template <ByteType T>
-constexpr vector_wrap_streambuf<T>::PosT vector_wrap_streambuf<T>::seekoff_put_area(OffT off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+template <ByteType T, bounds_check CheckT>
+T byte_reader<T, CheckT>::get()
 {
-    if (dir == std::ios_base::cur)
+    if (!check(1))
     {
-        if (off + Base::pptr() > Base::epptr())
-        {
-            throw std::out_of_range("put ptr offset out of range");
-        }
-        Base::pbump(static_cast<int>(off));
+        return T{};
     }
-    else if (dir == std::ios::end)
+    return m_data[m_pos++];
+}
+
+template <ByteType T, bounds_check CheckT>
+template <typename U>
+    requires std::is_trivially_copyable_v<U>
+U byte_reader<T, CheckT>::read()
+{
+    U value{};
+    if (check(sizeof(U)))
     {
-        if (off > 0 || static_cast<size_t>(-off) > get_put_area_size())
-        {
-            throw std::range_error("put ptr offset out of range");
-        }
-        Base::setp(Base::pbase(), Base::epptr());
-        Base::pbump(m_buffer.capacity() + off);
+        std::memcpy(&value, m_data.data() + m_pos, sizeof(U));
+        m_pos += sizeof(U);
     }
-    else if (dir == std::ios::beg)
+    return value;
+}
+
+template <ByteType T, bounds_check CheckT>
+template <ByteSwappable U>
+U byte_reader<T, CheckT>::read(std::endian order)
+{
+    const U value = read<U>();
+    return order == std::endian::native ? value : detail::byteswap(value);
+}
+
+template <ByteType T, bounds_check CheckT>
+template <typename U, size_t ExtentT>
+    requires std::is_trivially_copyable_v<U>
+void byte_reader<T, CheckT>::read_into(std::span<U, ExtentT> out)
+{
+    if (!out.empty() && check(out.size_bytes()))
     {
-        if (off < 0 || static_cast<size_t>(off) > get_put_area_size())
-        {
-            throw std::range_error("put ptr offset out of range");
-        }
-        Base::setp(Base::pbase(), Base::epptr());
-        Base::pbump(static_cast<int>(off));
+        std::memcpy(out.data(), m_data.data() + m_pos, out.size_bytes());
+        m_pos += out.size_bytes();
+    }
+}
+
+template <ByteType T, bounds_check CheckT>
+std::span<const T> byte_reader<T, CheckT>::read_view(size_t n)
+{
+    if (!check(n))
+    {
+        return {};
+    }
+    const auto view = m_data.subspan(m_pos, n);
+    m_pos += n;
+    return view;
+}
+
+template <ByteType T, bounds_check CheckT>
+void byte_reader<T, CheckT>::skip(size_t n)
+{
+    if (check(n))
+    {
+        m_pos += n;
+    }
+}
+
+template <ByteType T, bounds_check CheckT>
+void byte_reader<T, CheckT>::seek(size_t pos)
+{
+    if (pos <= m_pos || check(pos - m_pos))
+    {
+        m_pos = pos;
     }
-    return Base::pptr() - Base::pbase();
 }
 
 template <ByteType T>
-constexpr size_t vector_wrap_streambuf<T>::get_put_area_size() const
+byte_writer<T>::byte_writer(std::vector<T>& buffer, const growth_policy& growth)
+    : m_buffer(buffer)
+    , m_growth(growth)
+    , m_pos(buffer.size())
+    , m_size(buffer.size())
 {
-    return Base::epptr() - Base::pbase();
 }
 
 template <ByteType T>
-constexpr size_t vector_wrap_streambuf<T>::get_get_area_size() const
+byte_writer<T>::~byte_writer()
 {
-    return Base::egptr() - Base::eback();
+    flush();
 }
 
 template <ByteType T>
-vector_istream<T>::vector_istream(std::vector<T>& vec, std::ios_base::openmode mode)
-    : std::istream(&m_sbuf)
-    , m_sbuf(vec, mode | std::ios::in)
+void byte_writer<T>::flush()
 {
-    if (mode & std::ios_base::out)
+    m_buffer.resize(m_size);
+    m_window.reset();
+}
+
+template <ByteType T>
+T* byte_writer<T>::claim(size_t n)
+{
+    if (m_pos + n > m_buffer.size())
     {
-        throw std::runtime_error("invalid openmode");
+        m_window.extend(m_buffer, m_pos + n, m_growth);
     }
+    T* out = m_buffer.data() + m_pos;
+    m_pos += n;
+    m_size = std::max(m_size, m_pos);
+    return out;
 }
 
 template <ByteType T>
-vector_ostream<T>::vector_ostream(std::vector<T>& vec, std::ios_base::openmode mode)
-    : std::ostream(&m_sbuf)
-    , m_sbuf(vec, mode | std::ios::out)
+std::vector<T>& byte_writer<T>::buffer()
 {
-    if (mode & std::ios_base::in)
+    flush();
+    return m_buffer;
+}
+
+template <ByteType T>
+vector_istream<T> byte_writer<T>::istream()
+{
+    flush();
+    return vector_istream<T>(m_buffer);
+}
+
+template <ByteType T>
+void byte_writer<T>::put(T byte)
+{
+    *claim(1) = byte;
+}
+
+template <ByteType T>
+template <typename U>
+    requires std::is_trivially_copyable_v<U>
+void byte_writer<T>::write(const U& value)
+{
+    std::memcpy(claim(sizeof(U)), &value, sizeof(U));
+}
+
+template <ByteType T>
+template <ByteSwappable U>
+void byte_writer<T>::write(U value, std::endian order)
+{
+    write(order == std::endian::native ? value : detail::byteswap(value));
+}
+
+template <ByteType T>
+template <typename U, size_t ExtentT>
+    requires std::is_trivially_copyable_v<U>
+void byte_writer<T>::write_span(std::span<U, ExtentT> values)
+{
+    if (!values.empty())
     {
-        throw std::runtime_error("invalid openmode");
+        std::memcpy(claim(values.size_bytes()), values.data(), values.size_bytes());
+    }
+}
+
+template <ByteType T>
+void byte_writer<T>::seek(size_t pos)
+{
+    if (pos > m_size)
+    {
+        throw std::out_of_range("byte_writer: seek past the end of the buffer");
     }
+    m_pos = pos;
 }
 
 } // namespace Lud
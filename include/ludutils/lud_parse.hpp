@@ -2,15 +2,52 @@
 #define LUD_PARSE_HEADER
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
 #include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <optional>
+#include <stdexcept>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "lud_containers.hpp"
+#include "lud_cpu.hpp"
+
+// define LUD_NO_SIMD to force the scalar kernels, LUD_FORCE_SCALAR does the same at runtime for the dispatched ones
+#if !defined(LUD_NO_SIMD)
+    #if defined(__AVX2__)
+        #include <immintrin.h>
+        #define LUD_SIMD_AVX2 1
+    #endif
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #include <emmintrin.h>
+        #define LUD_SIMD_SSE2 1
+    #endif
+    #if defined(__SSSE3__) || defined(__AVX2__)
+        #include <tmmintrin.h>
+        #define LUD_SIMD_SSSE3 1
+    #endif
+    // bulk kernels are also built for instruction sets above the baseline and picked at runtime
+    #if defined(LUD_CPU_X86)
+        #include <immintrin.h>
+        #define LUD_SIMD_DISPATCH 1
+    #endif
+#endif
+
 namespace Lud {
 
 template <typename TypeT>
@@ -52,7 +89,17 @@ concept range_of_string_view = requires(RangeT r) {
 };
 
 template <integer_type N>
-std::optional<N> is_num(const std::string_view sv, int base = 10);
+constexpr std::optional<N> is_num(const std::string_view sv, int base = 10);
+
+/**
+ * @brief same as is_num(sv, base) with the base known at compile time,
+ *        base 10 is parsed 8 digits at a time instead of going through std::from_chars
+ *
+ * @tparam N integer type
+ * @tparam BaseT base of the parse
+ */
+template <integer_type N, int BaseT>
+constexpr std::optional<N> is_num(const std::string_view sv);
 template <real_type N>
 std::optional<N> is_num(const std::string_view sv, std::chars_format fmt = std::chars_format::general);
 
@@ -65,9 +112,9 @@ std::optional<N> is_num(const std::string_view sv, std::chars_format fmt = std::
 template <integer_type N, int BaseT = 10>
 struct parse_integer
 {
-    N operator()(const std::string_view sv) const
+    constexpr N operator()(const std::string_view sv) const
     {
-        return Lud::is_num<N>(sv, BaseT).value();
+        return Lud::is_num<N, BaseT>(sv).value();
     }
 };
 
@@ -86,16 +133,375 @@ struct parse_real
     }
 };
 
+struct quantity_unit
+{
+    std::string_view suffix;
+    // value of one suffix in the base unit
+    double scale;
+};
+
+// unit tables for ParseQuantity, new ones are just constexpr arrays of quantity_unit
+namespace units {
+
+// base unit is the second
+inline constexpr std::array<quantity_unit, 7> durations{{
+    {"ns", 1e-9}, {"us", 1e-6}, {"ms", 1e-3}, {"s", 1}, {"min", 60}, {"h", 3600}, {"d", 86400},
+}};
+
+// base unit is the byte, binary prefixes are powers of 1024 and decimal ones of 1000
+inline constexpr std::array<quantity_unit, 10> bytes{{
+    {"B", 1},
+    {"KiB", 1ull << 10}, {"MiB", 1ull << 20}, {"GiB", 1ull << 30}, {"TiB", 1ull << 40},
+    {"kB", 1e3}, {"KB", 1e3}, {"MB", 1e6}, {"GB", 1e9}, {"TB", 1e12},
+}};
+
+// bare SI prefixes, as in 1.5G or 20k
+inline constexpr std::array<quantity_unit, 9> si{{
+    {"p", 1e-12}, {"n", 1e-9}, {"u", 1e-6}, {"m", 1e-3}, {"k", 1e3}, {"K", 1e3}, {"M", 1e6}, {"G", 1e9}, {"T", 1e12},
+}};
+
+} // namespace units
+
+struct quantity_options
+{
+    // forms accepted besides the unit suffixes
+    bool plain = true;
+    bool fraction = true;
+    bool percentage = true;
+    // suffixes accepted after the number, when several match the longest wins
+    // they are tried before the other forms, so a suffix may contain '/' or '%'
+    std::span<const quantity_unit> units{};
+};
+
+/**
+ * @brief parses a number that may be written as a fraction "a/b", a percentage "x%"
+ *        or with a unit suffix "250ms", each part is parsed as strictly as is_num
+ *        single pass over the string and no allocations
+ *
+ *        a fraction with a 0 denominator is NaN, percentages are divided by 100
+ *        and a number with a suffix is multiplied by its scale
+ *
+ * usage:
+ *     Lud::ParseQuantity<double>("4KiB", {.units = Lud::units::bytes}) == 4096
+ *
+ * @tparam N real type
+ */
+template <real_type N>
+std::optional<N> ParseQuantity(const std::string_view sv, const quantity_options& options = {});
+
+/**
+ * @brief ParseQuantity accepting only "a/b"
+ */
 template <real_type N>
 std::optional<N> is_fraction(const std::string_view sv);
+
+/**
+ * @brief ParseQuantity accepting only "x%"
+ */
 template <real_type N>
 std::optional<N> is_percentage(const std::string_view sv);
 
 template <range_of_string_view R = std::vector<std::string_view>>
-R Split(const std::string_view str, const std::string_view delim, size_t n = 0);
+constexpr R Split(const std::string_view str, const std::string_view delim, size_t n = 0);
+
+template <range_of_string_view R = std::vector<std::string_view>>
+constexpr R Split(const std::string_view str, char delim, size_t n = 0);
+
+/**
+ * @brief Split with the n limit known at compile time, at most SplitsT + 1 tokens come out
+ *        so they are kept inline and the call never allocates
+ *        for unbounded splits that are usually short use Split<Lud::small_vector<std::string_view, N>>
+ *
+ * @tparam SplitsT same as n in Split, must not be 0
+ */
+template <size_t SplitsT>
+constexpr static_vector<std::string_view, SplitsT + 1> SplitN(const std::string_view str, char delim);
+
+template <size_t SplitsT>
+constexpr static_vector<std::string_view, SplitsT + 1> SplitN(const std::string_view str, const std::string_view delim);
+
+/**
+ * @brief splits a literal at compile time into exactly CountT tokens, anything else fails to compile
+ *
+ * @tparam CountT amount of tokens
+ */
+template <size_t CountT>
+consteval std::array<std::string_view, CountT> SplitArray(const std::string_view str, char delim);
+
+template <size_t CountT>
+consteval std::array<std::string_view, CountT> SplitArray(const std::string_view str, const std::string_view delim);
+
+/**
+ * @brief parses a literal of CountT delimited integers at compile time, a malformed token fails to compile
+ *        so that tables embedded in the binary cost nothing at startup
+ *
+ * @tparam N integer type
+ * @tparam CountT amount of numbers
+ * @tparam BaseT base of the parse
+ */
+template <integer_type N, size_t CountT, int BaseT = 10>
+consteval std::array<N, CountT> ParseArray(const std::string_view str, char delim);
+
+template <integer_type N, size_t CountT, int BaseT = 10>
+consteval std::array<N, CountT> ParseArray(const std::string_view str, const std::string_view delim);
+
+template <typename DelimT>
+concept split_delim_type = requires {
+    requires std::same_as<DelimT, char> || std::same_as<DelimT, std::string_view>;
+};
+
+/**
+ * @brief lazy version of Split, yields the tokens as std::string_view while iterating
+ *        same semantics as Split: empty tokens are skipped and at most n splits are done,
+ *        the rest of the string being yielded as the last token
+ *
+ * @tparam DelimT either char or std::string_view
+ */
+template <split_delim_type DelimT>
+class split_view : public std::ranges::view_interface<split_view<DelimT>>
+{
+public:
+    class iterator
+    {
+    public:
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        iterator() = default;
+        constexpr iterator(std::string_view str, DelimT delim, size_t n);
+
+        constexpr std::string_view operator*() const { return m_current; }
+
+        constexpr iterator& operator++();
+        constexpr iterator operator++(int);
+
+        constexpr bool operator==(const iterator& other) const;
+        constexpr bool operator==(std::default_sentinel_t) const { return m_done; }
+
+    private:
+        constexpr void next();
+
+    private:
+        std::string_view m_rest{};
+        std::string_view m_current{};
+        DelimT m_delim{};
+        size_t m_n = 0;
+        size_t m_count = 0;
+        bool m_done = true;
+    };
+
+    split_view() = default;
+    constexpr split_view(std::string_view str, DelimT delim, size_t n = 0);
+
+    constexpr iterator begin() const { return iterator(m_str, m_delim, m_n); }
+    constexpr std::default_sentinel_t end() const { return std::default_sentinel; }
+
+private:
+    std::string_view m_str{};
+    DelimT m_delim{};
+    size_t m_n = 0;
+};
+
+split_view(std::string_view, const char*) -> split_view<std::string_view>;
+split_view(std::string_view, const char*, size_t) -> split_view<std::string_view>;
+
+namespace views {
+
+/**
+ * @brief range adaptor for Lud::split_view, usable as
+ *        str | Lud::views::split_sv(',') | std::views::transform(Lud::parse_integer<int>{})
+ *
+ * @tparam DelimT either char or std::string_view
+ */
+template <split_delim_type DelimT>
+struct split_sv_closure
+{
+    DelimT delim;
+    size_t n = 0;
+
+    friend constexpr split_view<DelimT> operator|(std::string_view str, const split_sv_closure& closure)
+    {
+        return split_view<DelimT>(str, closure.delim, closure.n);
+    }
+};
+
+constexpr split_sv_closure<char> split_sv(char delim, size_t n = 0);
+constexpr split_sv_closure<std::string_view> split_sv(std::string_view delim, size_t n = 0);
+
+} // namespace views
+
+struct parse_numbers_result
+{
+    // amount of numbers appended to out
+    size_t count = 0;
+    // index of the first token that is not a number, npos if all of them were
+    size_t error_token = std::string_view::npos;
+    // offset of that token in the buffer
+    size_t error_offset = std::string_view::npos;
+
+    constexpr explicit operator bool() const { return error_token == std::string_view::npos; }
+};
+
+/**
+ * @brief tokenizes and converts in a single pass, same as Split + transform(parse_integer/parse_real)
+ *        but without the intermediate vector and without throwing, tokens are split like Split
+ *        and parsed like is_num, integers in base 10
+ *
+ * @tparam N number type
+ * @param out numbers get appended here, it is never cleared so its capacity can be reused
+ * @return result with the amount parsed and, if any, where the first malformed token is,
+ *         parsing stops at that token
+ */
+template <number_type N>
+parse_numbers_result ParseNumbers(const std::string_view str, char delim, std::vector<N>& out);
+
+template <number_type N>
+parse_numbers_result ParseNumbers(const std::string_view str, const std::string_view delim, std::vector<N>& out);
+
+struct parallel_options
+{
+    // threads to use, 0 means std::thread::hardware_concurrency()
+    size_t threads = 0;
+    // buffers are never cut into chunks smaller than this, small buffers run on the calling thread
+    size_t min_chunk_size = size_t{1} << 20;
+};
+
+/**
+ * @brief Split for big buffers, the buffer is cut into one chunk per thread on delimiter boundaries,
+ *        the chunks are tokenized at the same time and the results stitched in order
+ *        the result is the same as Split(str, delim), splitting lines is done with '\n' as delim
+ *        string delimiters that can overlap themselves ("aa", "aba") are split serially
+ */
+template <range_of_string_view R = std::vector<std::string_view>>
+R ParallelSplit(const std::string_view str, char delim, const parallel_options& options = {});
 
 template <range_of_string_view R = std::vector<std::string_view>>
-R Split(const std::string_view str, char delim, size_t n = 0);
+R ParallelSplit(const std::string_view str, const std::string_view delim, const parallel_options& options = {});
+
+/**
+ * @brief ParseNumbers for big buffers, chunked like ParallelSplit
+ *        out and the result are the same as ParseNumbers(str, delim, out)
+ */
+template <number_type N>
+parse_numbers_result ParallelParseNumbers(const std::string_view str, char delim, std::vector<N>& out, const parallel_options& options = {});
+
+template <number_type N>
+parse_numbers_result ParallelParseNumbers(const std::string_view str, const std::string_view delim, std::vector<N>& out, const parallel_options& options = {});
+
+/**
+ * @brief RFC 4180 reader over a buffer, yields one record at a time as string_views into the buffer
+ *        records end in "\n", "\r\n" or "\r", quoted fields may contain delimiters and line breaks
+ *        and only fields with doubled quotes are copied, into storage owned by the reader
+ *        fields are valid until the next call to next(), the buffer must outlive the reader
+ *        malformed input (unterminated quotes or text after a closing quote) throws std::invalid_argument
+ *
+ * usage:
+ *     Lud::csv_reader reader(buffer);
+ *     while (reader.next())
+ *     {
+ *         for (std::string_view field : reader.fields()) ...
+ *     }
+ */
+class csv_reader
+{
+public:
+    explicit csv_reader(const std::string_view data, char delim = ',', char quote = '"');
+
+    template <typename T>
+        requires(sizeof(T) == 1)
+    explicit csv_reader(std::span<const T> data, char delim = ',', char quote = '"');
+
+    /**
+     * @brief reads the next record, false once the buffer is exhausted
+     *        a line break at the end of the buffer does not start a new record
+     */
+    bool next();
+
+    const std::vector<std::string_view>& fields() const { return m_fields; }
+
+    // offset in the buffer of the current record
+    size_t offset() const { return m_record_offset; }
+
+private:
+    size_t read_quoted(size_t pos);
+
+    [[noreturn]] void throw_malformed(const char* what, size_t pos) const;
+
+private:
+    std::string_view m_data;
+    char m_delim;
+    char m_quote;
+    size_t m_pos = 0;
+    size_t m_record_offset = 0;
+    // storage is kept between records so its capacity is reused
+    std::vector<std::string_view> m_fields;
+    std::string m_unescaped;
+    // field index and offset in m_unescaped of the fields that had doubled quotes
+    std::vector<std::pair<size_t, size_t>> m_escaped;
+};
+
+/**
+ * @brief offsets of the line starts of a buffer, giving any line as a string_view in constant time
+ *        lines end in "\n" or "\r\n", the line break is not part of the line
+ *        offsets take 4 bytes each and move to 8 bytes only once the buffer grows past 4 GiB
+ *        the index can be extended as data is appended to the buffer, for example to tail a log
+ *
+ * usage:
+ *     Lud::line_index index(log);
+ *     ...                  // more data appended to log
+ *     index.update(log);   // only the new data is scanned
+ *     std::string_view last = index.line(index.size() - 1);
+ */
+class line_index
+{
+public:
+    line_index() = default;
+    explicit line_index(const std::string_view buffer);
+
+    /**
+     * @brief indexes the data added to the end of the buffer since the last call
+     *        buffer must start with the data already indexed, but may have moved, like a std::string that reallocated
+     *        a shorter buffer throws std::invalid_argument
+     */
+    void update(const std::string_view buffer);
+
+    /**
+     * @brief number of lines, a line break at the end of the buffer does not start a new line
+     */
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief line idx without its line break, idx must be less than size()
+     *        the last line may still be incomplete, a '\r' it ends in is dropped as it may be half of a "\r\n"
+     */
+    std::string_view line(size_t idx) const;
+    std::string_view operator[](size_t idx) const { return line(idx); }
+
+    // offset in the buffer where line idx starts
+    size_t offset(size_t idx) const;
+
+    // line the byte at offset belongs to, offsets past the end give the last line
+    size_t line_of(size_t offset) const;
+
+    std::string_view buffer() const { return m_buffer; }
+
+    // true once the offsets take 8 bytes each
+    bool is_wide() const { return m_wide; }
+
+private:
+    // calls f with whichever offsets vector is in use
+    template <typename F>
+    decltype(auto) visit_offsets(F&& f) const;
+
+private:
+    std::string_view m_buffer;
+    // start of every line, plus the end of the buffer when it ends in a line break
+    std::vector<uint32_t> m_offsets32{0};
+    std::vector<uint64_t> m_offsets64;
+    bool m_wide = false;
+};
 
 template <string_container Container>
 std::string Join(const Container& container, const std::string_view delim);
@@ -109,9 +515,147 @@ std::string Join(T first, T last, const std::string_view delim);
 template <std::input_iterator T>
 std::string Join(T first, T last, char delim);
 
-std::string_view RemovePrefix(const std::string_view str, const std::string_view prefix);
+/**
+ * @brief appends the joined range to out, reusing its capacity,
+ *        for forward ranges the total size is computed first so out grows at most once,
+ *        that reads every element twice, so it is skipped when dereferencing builds a new string each time
+ *
+ * @return out
+ */
+template <string_container Container>
+std::string& JoinTo(std::string& out, const Container& container, const std::string_view delim);
+
+template <string_container Container>
+std::string& JoinTo(std::string& out, const Container& container, char delim);
+
+template <std::input_iterator T>
+std::string& JoinTo(std::string& out, T first, T last, const std::string_view delim);
+
+template <std::input_iterator T>
+std::string& JoinTo(std::string& out, T first, T last, char delim);
+
+/**
+ * @brief writes the joined range through an output iterator
+ *
+ * @return iterator past the last written char
+ */
+template <std::output_iterator<char> OutT, std::input_iterator T>
+OutT JoinTo(OutT out, T first, T last, const std::string_view delim);
+
+template <std::output_iterator<char> OutT, std::input_iterator T>
+OutT JoinTo(OutT out, T first, T last, char delim);
 
-std::string_view RemoveSuffix(const std::string_view str, const std::string_view suffix);
+/**
+ * @brief base 10 text of an integer, the inverse of is_num, digits are written two at a time
+ *        std::string& overloads append to out and span ones write at its start, returning the written part
+ *        and throwing std::length_error if it does not fit, same as the caller buffer string transforms
+ */
+template <integer_type N>
+std::string FormatInteger(N value);
+
+template <integer_type N>
+std::string& FormatInteger(std::string& out, N value);
+
+template <integer_type N>
+std::span<char> FormatInteger(std::span<char> out, N value);
+
+/**
+ * @brief shortest text that is_num reads back to the same value, through std::to_chars
+ */
+template <real_type N>
+std::string FormatReal(N value);
+
+template <real_type N>
+std::string& FormatReal(std::string& out, N value);
+
+template <real_type N>
+std::span<char> FormatReal(std::span<char> out, N value);
+
+/**
+ * @brief text of a real with the given format and precision, as std::to_chars
+ */
+template <real_type N>
+std::string FormatReal(N value, std::chars_format fmt, int precision);
+
+template <real_type N>
+std::string& FormatReal(std::string& out, N value, std::chars_format fmt, int precision);
+
+template <typename RangeT>
+concept range_of_numbers = requires {
+    requires std::ranges::forward_range<RangeT>;
+    requires number_type<std::ranges::range_value_t<RangeT>>;
+};
+
+/**
+ * @brief the inverse of ParseNumbers, numbers are formatted like FormatInteger and FormatReal
+ *        straight into one buffer, which is sized once from the digit counts before writing
+ */
+template <range_of_numbers R>
+std::string JoinNumbers(const R& numbers, const std::string_view delim);
+
+template <range_of_numbers R>
+std::string JoinNumbers(const R& numbers, char delim);
+
+/**
+ * @brief appends to out instead, like JoinTo
+ *
+ * @return out
+ */
+template <range_of_numbers R>
+std::string& JoinNumbersTo(std::string& out, const R& numbers, const std::string_view delim);
+
+template <range_of_numbers R>
+std::string& JoinNumbersTo(std::string& out, const R& numbers, char delim);
+
+struct decode_result
+{
+    // amount of bytes appended to out
+    size_t count = 0;
+    // offset in the text of the first char that could not be decoded, npos if all of them were
+    size_t error_offset = std::string_view::npos;
+
+    constexpr explicit operator bool() const { return error_offset == std::string_view::npos; }
+};
+
+/**
+ * @brief two hex digits per byte, 16 bytes at a time where the cpu allows it
+ *
+ * @param upper true for "ABCDEF" digits, false for "abcdef"
+ */
+std::string HexEncode(std::span<const uint8_t> data, bool upper = false);
+
+// appends to out instead
+std::string& HexEncode(std::string& out, std::span<const uint8_t> data, bool upper = false);
+
+/**
+ * @brief inverse of HexEncode, digits of either case are accepted
+ *
+ * @param out bytes get appended here, so the result can be wrapped by a vector_istream without copying,
+ *        it is left as it was when the text is not valid
+ * @return result with the amount of bytes and, if any, the first char that is not a digit,
+ *         for an odd amount of digits that is the last one
+ */
+decode_result HexDecode(const std::string_view str, std::vector<uint8_t>& out);
+
+/**
+ * @brief standard base64 (RFC 4648 section 4) with '=' padding, 12 bytes at a time where the cpu allows it
+ */
+std::string Base64Encode(std::span<const uint8_t> data);
+
+// appends to out instead
+std::string& Base64Encode(std::string& out, std::span<const uint8_t> data);
+
+/**
+ * @brief inverse of Base64Encode, the padding may be left out, whitespace is not skipped
+ *
+ * @param out as in HexDecode
+ * @return as in HexDecode, a lone char after the last full group is an error
+ */
+decode_result Base64Decode(const std::string_view str, std::vector<uint8_t>& out);
+
+constexpr std::string_view RemovePrefix(const std::string_view str, const std::string_view prefix);
+
+constexpr std::string_view RemoveSuffix(const std::string_view str, const std::string_view suffix);
 
 std::string ToUpper(const std::string_view str);
 
@@ -121,22 +665,186 @@ std::string ToTitle(const std::string_view str);
 
 std::string Capitalize(const std::string_view str);
 
-std::string_view LStrip(const std::string_view str);
+constexpr std::string_view LStrip(const std::string_view str);
 
-std::string_view RStrip(const std::string_view str);
+constexpr std::string_view RStrip(const std::string_view str);
 
-std::string_view Strip(const std::string_view str);
+constexpr std::string_view Strip(const std::string_view str);
 
 std::string Reverse(const std::string_view str);
 
+/**
+ * @brief replaces every non overlapping occurrence of pattern, left to right, in a single pass,
+ *        text coming from the replacement is never searched again
+ *
+ * @return new string, sized once before copying
+ */
 std::string Replace(const std::string_view str, const std::string_view pattern, const std::string_view replacement);
 
 std::string Replace(const std::string_view str, char pattern, char replacement);
 
+/**
+ * @brief versions of ToUpper, ToLower, ToTitle, Capitalize, Reverse and Replace that write into a caller buffer
+ *        so a scratch buffer can be reused between calls
+ *
+ *        std::string: the result is appended to out, growing it with resize_and_overwrite so the new chars
+ *                     are never zero initialized, str may be a view of out
+ *        std::span: the result is written at the start of out, returns the written part and
+ *                   throws std::length_error if it does not fit, out must not overlap str
+ *        output iterator: returns the iterator past the last written char
+ */
+std::string& ToUpper(std::string& out, const std::string_view str);
+std::span<char> ToUpper(std::span<char> out, const std::string_view str);
+template <std::output_iterator<char> OutT>
+OutT ToUpper(OutT out, const std::string_view str);
+
+std::string& ToLower(std::string& out, const std::string_view str);
+std::span<char> ToLower(std::span<char> out, const std::string_view str);
+template <std::output_iterator<char> OutT>
+OutT ToLower(OutT out, const std::string_view str);
+
+std::string& ToTitle(std::string& out, const std::string_view str);
+std::span<char> ToTitle(std::span<char> out, const std::string_view str);
+template <std::output_iterator<char> OutT>
+OutT ToTitle(OutT out, const std::string_view str);
+
+std::string& Capitalize(std::string& out, const std::string_view str);
+std::span<char> Capitalize(std::span<char> out, const std::string_view str);
+template <std::output_iterator<char> OutT>
+OutT Capitalize(OutT out, const std::string_view str);
+
+std::string& Reverse(std::string& out, const std::string_view str);
+std::span<char> Reverse(std::span<char> out, const std::string_view str);
+template <std::output_iterator<char> OutT>
+OutT Reverse(OutT out, const std::string_view str);
+
+std::string& Replace(std::string& out, const std::string_view str, const std::string_view pattern, const std::string_view replacement);
+std::span<char> Replace(std::span<char> out, const std::string_view str, const std::string_view pattern, const std::string_view replacement);
+template <std::output_iterator<char> OutT>
+OutT Replace(OutT out, const std::string_view str, const std::string_view pattern, const std::string_view replacement);
+
+std::string& Replace(std::string& out, const std::string_view str, char pattern, char replacement);
+std::span<char> Replace(std::span<char> out, const std::string_view str, char pattern, char replacement);
+template <std::output_iterator<char> OutT>
+OutT Replace(OutT out, const std::string_view str, char pattern, char replacement);
+
+/**
+ * @brief precompiled set of pattern -> replacement pairs to be used with ReplaceAll,
+ *        meant to be built once and reused, building the automaton is the expensive part
+ *
+ *        backed by an Aho-Corasick automaton over byte classes, matches are leftmost-longest:
+ *        of the matches starting the earliest, the longest wins
+ */
+class replace_set
+{
+public:
+    using pair_type = std::pair<std::string_view, std::string_view>;
+
+    replace_set(std::initializer_list<pair_type> pairs);
+
+    template <std::ranges::input_range RangeT>
+        requires std::convertible_to<std::ranges::range_value_t<RangeT>, pair_type>
+    explicit replace_set(const RangeT& pairs);
+
+    /**
+     * @brief calls f(position, pattern index) for every leftmost-longest non overlapping match in str
+     */
+    template <typename F>
+    void for_each_match(const std::string_view str, F&& f) const;
+
+    size_t pattern_size(size_t idx) const { return m_patterns[idx].size(); }
+    std::string_view replacement(size_t idx) const { return m_replacements[idx]; }
+
+    size_t size() const { return m_patterns.size(); }
+
+private:
+    void add(std::string_view pattern, std::string_view replacement);
+    void build();
+
+    constexpr uint32_t next_state(uint32_t state, char c) const
+    {
+        return m_transitions[state * m_class_count + m_classes[static_cast<unsigned char>(c)]];
+    }
+
+private:
+    static constexpr int32_t no_match = -1;
+
+    std::vector<std::string> m_patterns;
+    std::vector<std::string> m_replacements;
+
+    std::array<uint16_t, 256> m_classes{};
+    size_t m_class_count = 1;
+
+    std::vector<uint32_t> m_transitions;
+    // longest pattern ending at each state
+    std::vector<int32_t> m_match;
+    std::vector<uint32_t> m_depth;
+};
+
+/**
+ * @brief applies every substitution of the set in a single pass over str
+ */
+std::string ReplaceAll(const std::string_view str, const replace_set& set);
+
+/**
+ * @brief convenience overload, builds the set for this call only, prefer reusing a replace_set
+ */
+std::string ReplaceAll(const std::string_view str, std::initializer_list<replace_set::pair_type> pairs);
+
+namespace detail {
+// nibble rows and bitmap of a char_set, see char_set::find_first
+using find_in_set_fn = size_t (*)(const uint8_t* rows, const uint64_t* bits, const char* data, size_t size);
+} // namespace detail
+
+/**
+ * @brief set of bytes as a 256 bit bitmap, meant to be built once and reused in ContainsAny/ContainsAll
+ *        it also keeps the nibble tables used to classify 16/32 bytes at a time with a shuffle lookup
+ */
+class char_set
+{
+public:
+    constexpr char_set() = default;
+    constexpr explicit char_set(const std::string_view chars);
+
+    constexpr void insert(char c);
+    constexpr void erase(char c);
+    constexpr bool contains(char c) const;
+
+    // amount of distinct chars in the set
+    constexpr size_t size() const;
+    constexpr bool empty() const { return size() == 0; }
+
+    /**
+     * @brief position of the first char of str that is in the set, npos if there is none
+     *        the scan is dispatched on the instruction sets of the running cpu
+     */
+    size_t find_first(const std::string_view str) const;
+
+    // the same scan with a given kernel, to check the kernels against each other
+    size_t find_first(const std::string_view str, detail::find_in_set_fn kernel) const;
+
+    constexpr bool operator==(const char_set& other) const { return m_bits == other.m_bits; }
+
+private:
+    std::array<uint64_t, 4> m_bits{};
+    // m_rows[n][lo] has bit (hi % 8) set when the byte (hi << 4 | lo) is in the set, n being hi / 8
+    std::array<std::array<uint8_t, 16>, 2> m_rows{};
+};
+
+/**
+ * @brief true if any char of pattern is in str
+ */
 bool ContainsAny(const std::string_view str, const std::string_view pattern);
 
+bool ContainsAny(const std::string_view str, const char_set& set);
+
+/**
+ * @brief true if every distinct char of pattern is in str, an empty pattern is always contained
+ */
 bool ContainsAll(const std::string_view str, const std::string_view pattern);
 
+bool ContainsAll(const std::string_view str, const char_set& set);
+
 bool IsBlank(const std::string_view str);
 
 namespace inplace {
@@ -160,408 +868,2908 @@ std::string& Strip(std::string& str);
 
 std::string& Reverse(std::string& str);
 
+/**
+ * @brief same semantics as Lud::Replace, when the replacement is not longer than the pattern
+ *        the string is compacted in its own buffer, otherwise it is rebuilt out of place once
+ */
 std::string& Replace(std::string& str, const std::string_view pattern, const std::string_view replacement);
 
 std::string& Replace(std::string& str, char pattern, char replacement);
+
+std::string& ReplaceAll(std::string& str, const replace_set& set);
 } // namespace inplace
 
 } // namespace Lud
 
 // implementation==============================================================================
 
-template <Lud::integer_type N>
-std::optional<N> Lud::is_num(const std::string_view sv, int base /*=10*/)
+namespace Lud::detail {
+
+#if defined(LUD_SIMD_AVX2)
+inline constexpr size_t scan_block_size = 32;
+#else
+inline constexpr size_t scan_block_size = 16;
+#endif
+
+/**
+ * @brief bitmask of the bytes equal to c in the scan_block_size bytes starting at p
+ */
+inline uint32_t char_block_mask(const char* p, char c)
 {
-    // house keeping since from chars does not recognize leading plus sign and leading whitespace
-    auto check = Strip(sv);
-    // inplace::RemovePrefix(check, "+");
-    // switch (base)
-    // {
-    // case 16:
-    //     inplace::RemovePrefix(check, "0X");
-    //     break;
-    // case 2:
-    //     inplace::RemovePrefix(check, "0B");
-    //     break;
-    // case 8:
-    //     inplace::RemovePrefix(check, "0O");
-    //     inplace::RemovePrefix(check, "0");
+#if defined(LUD_SIMD_AVX2)
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(c))));
+#elif defined(LUD_SIMD_SSE2)
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(c))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < scan_block_size; i++)
+    {
+        mask |= static_cast<uint32_t>(p[i] == c) << i;
+    }
+    return mask;
+#endif
+}
+
+inline constexpr uint32_t scan_block_full_mask = static_cast<uint32_t>((uint64_t{1} << scan_block_size) - 1);
+
+/**
+ * @brief position of the first delim, '\n' or '\r' in str starting from pos, str.size() if none
+ */
+inline size_t find_csv_special(const std::string_view str, size_t pos, char delim)
+{
+    const char* data = str.data();
+    for (; pos + scan_block_size <= str.size(); pos += scan_block_size)
+    {
+        const uint32_t mask = char_block_mask(data + pos, delim)
+                            | char_block_mask(data + pos, '\n')
+                            | char_block_mask(data + pos, '\r');
+        if (mask != 0)
+        {
+            return pos + std::countr_zero(mask);
+        }
+    }
+    for (; pos < str.size(); pos++)
+    {
+        if (data[pos] == delim || data[pos] == '\n' || data[pos] == '\r')
+        {
+            return pos;
+        }
+    }
+    return str.size();
+}
+
+/**
+ * @brief true if a proper prefix of delim is also a suffix, occurrences of those can overlap
+ *        so a search started in the middle of the buffer may not find the ones a serial split would
+ */
+inline bool self_overlapping(const std::string_view delim)
+{
+    for (size_t k = 1; k < delim.size(); k++)
+    {
+        if (delim.substr(0, k) == delim.substr(delim.size() - k))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief cuts str into chunks that end right after a delimiter, one per thread and no smaller than min_chunk_size
+ */
+template <typename DelimT>
+std::vector<std::string_view> parallel_chunks(const std::string_view str, DelimT delim, const parallel_options& options)
+{
+    size_t delim_size = 1;
+    if constexpr (std::same_as<DelimT, std::string_view>)
+    {
+        delim_size = delim.size();
+        if (delim.empty() || self_overlapping(delim))
+        {
+            return {str};
+        }
+    }
+    const size_t threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    const size_t count = std::min(threads, std::max<size_t>(1, str.size() / std::max<size_t>(1, options.min_chunk_size)));
+
+    std::vector<std::string_view> chunks;
+    chunks.reserve(count);
+    size_t begin = 0;
+    for (size_t i = 1; i < count && begin < str.size(); i++)
+    {
+        const size_t found = str.find(delim, std::max(begin, str.size() / count * i));
+        const size_t end = found == std::string_view::npos ? str.size() : found + delim_size;
+        chunks.push_back(str.substr(begin, end - begin));
+        begin = end;
+    }
+    if (begin < str.size() || chunks.empty())
+    {
+        chunks.push_back(str.substr(begin));
+    }
+    return chunks;
+}
+
+/**
+ * @brief calls f(idx, chunk) for every chunk, each one on its own thread except the first
+ *        which runs on the calling one, the first exception thrown is rethrown after joining
+ */
+template <typename F>
+void run_chunks(const std::vector<std::string_view>& chunks, F&& f)
+{
+    std::vector<std::exception_ptr> errors(chunks.size());
+    const auto run = [&](size_t idx) {
+        try
+        {
+            f(idx, chunks[idx]);
+        }
+        catch (...)
+        {
+            errors[idx] = std::current_exception();
+        }
+    };
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(chunks.size() - 1);
+        for (size_t i = 1; i < chunks.size(); i++)
+        {
+            workers.emplace_back(run, i);
+        }
+        run(0);
+    }
+    for (const auto& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+template <range_of_string_view R, typename DelimT>
+R parallel_split(const std::string_view str, DelimT delim, const parallel_options& options)
+{
+    const auto chunks = parallel_chunks(str, delim, options);
+    if (chunks.size() == 1)
+    {
+        return Split<R>(str, delim);
+    }
+    std::vector<std::vector<std::string_view>> tokens(chunks.size());
+    run_chunks(chunks, [&](size_t idx, std::string_view chunk) {
+        tokens[idx] = Split(chunk, delim);
+    });
+
+    R r;
+    if constexpr (requires(R& rng, size_t n) { rng.reserve(n); })
+    {
+        size_t total = 0;
+        for (const auto& part : tokens)
+        {
+            total += part.size();
+        }
+        r.reserve(total);
+    }
+    for (const auto& part : tokens)
+    {
+        std::ranges::copy(part, std::inserter(r, r.end()));
+    }
+    return r;
+}
+
+template <typename N, typename DelimT>
+parse_numbers_result parallel_parse_numbers(const std::string_view str, DelimT delim, std::vector<N>& out, const parallel_options& options)
+{
+    const auto chunks = parallel_chunks(str, delim, options);
+    if (chunks.size() == 1)
+    {
+        return ParseNumbers(str, delim, out);
+    }
+    std::vector<std::vector<N>> values(chunks.size());
+    std::vector<parse_numbers_result> results(chunks.size());
+    run_chunks(chunks, [&](size_t idx, std::string_view chunk) {
+        results[idx] = ParseNumbers(chunk, delim, values[idx]);
+    });
+
+    parse_numbers_result res;
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+        out.insert(out.end(), values[i].begin(), values[i].end());
+        if (!results[i])
+        {
+            res.error_token = res.count + results[i].error_token;
+            res.error_offset = static_cast<size_t>(chunks[i].data() - str.data()) + results[i].error_offset;
+            res.count += results[i].count;
+            break;
+        }
+        res.count += results[i].count;
+    }
+    return res;
+}
+
+// the whitespace set used by Strip and friends: "\t\n\r "
+inline constexpr std::array<bool, 256> whitespace_table = [] {
+    std::array<bool, 256> table{};
+    table['\t'] = true;
+    table['\n'] = true;
+    table['\r'] = true;
+    table[' '] = true;
+    return table;
+}();
+
+constexpr bool is_whitespace(char c)
+{
+    return whitespace_table[static_cast<unsigned char>(c)];
+}
+
+/**
+ * @brief calls f with the position of every c in str in order, scanning scan_block_size bytes at a time
+ *
+ * @param f callable taking the position, returning false stops the scan
+ */
+template <typename F>
+constexpr void scan_char(const std::string_view str, char c, F&& f)
+{
+    const char* data = str.data();
+    size_t i = 0;
+    if !consteval
+    {
+        for (; i + scan_block_size <= str.size(); i += scan_block_size)
+        {
+            uint32_t mask = char_block_mask(data + i, c);
+            while (mask != 0)
+            {
+                if (!f(i + std::countr_zero(mask)))
+                {
+                    return;
+                }
+                mask &= mask - 1;
+            }
+        }
+    }
+    for (; i < str.size(); i++)
+    {
+        if (data[i] == c && !f(i))
+        {
+            return;
+        }
+    }
+}
+
+
+/**
+ * @brief bitmask of the whitespace bytes in the scan_block_size bytes starting at p
+ */
+inline uint32_t whitespace_block_mask(const char* p)
+{
+#if defined(LUD_SIMD_AVX2)
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i ws = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\r')))
+    );
+    return static_cast<uint32_t>(_mm256_movemask_epi8(ws));
+#elif defined(LUD_SIMD_SSE2)
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i ws = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))),
+        _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\r')))
+    );
+    return static_cast<uint32_t>(_mm_movemask_epi8(ws));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < scan_block_size; i++)
+    {
+        mask |= static_cast<uint32_t>(is_whitespace(p[i])) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief position of the first non whitespace char of str, npos if it is blank
+ */
+constexpr size_t first_not_whitespace(const std::string_view str)
+{
+    const char* data = str.data();
+    if (str.empty())
+    {
+        return std::string_view::npos;
+    }
+    // most strings don't start with whitespace, don't bother with blocks for those
+    if (!is_whitespace(data[0]))
+    {
+        return 0;
+    }
+    size_t i = 0;
+    if !consteval
+    {
+        for (; i + scan_block_size <= str.size(); i += scan_block_size)
+        {
+            const uint32_t mask = whitespace_block_mask(data + i);
+            if (mask != scan_block_full_mask)
+            {
+                return i + std::countr_one(mask);
+            }
+        }
+    }
+    for (; i < str.size(); i++)
+    {
+        if (!is_whitespace(data[i]))
+        {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+/**
+ * @brief position of the last non whitespace char of str, npos if it is blank
+ */
+constexpr size_t last_not_whitespace(const std::string_view str)
+{
+    const char* data = str.data();
+    if (str.empty())
+    {
+        return std::string_view::npos;
+    }
+    if (!is_whitespace(data[str.size() - 1]))
+    {
+        return str.size() - 1;
+    }
+    size_t i = str.size();
+    if !consteval
+    {
+        for (; i >= scan_block_size; i -= scan_block_size)
+        {
+            const uint32_t mask = ~whitespace_block_mask(data + i - scan_block_size) & scan_block_full_mask;
+            if (mask != 0)
+            {
+                return i - scan_block_size + std::bit_width(mask) - 1;
+            }
+        }
+    }
+    for (; i > 0; i--)
+    {
+        if (!is_whitespace(data[i - 1]))
+        {
+            return i - 1;
+        }
+    }
+    return std::string_view::npos;
+}
+
+
+/**
+ * @brief changes the case of a single char, ASCII is handled without going through the locale
+ *
+ * @tparam UpperT true to convert to upper case, false for lower case
+ */
+template <bool UpperT>
+inline char convert_case(char c)
+{
+    constexpr char first = UpperT ? 'a' : 'A';
+    constexpr char last = UpperT ? 'z' : 'Z';
+    if (static_cast<unsigned char>(c) < 0x80)
+    {
+        return (c >= first && c <= last) ? static_cast<char>(c ^ 0x20) : c;
+    }
+    const auto uc = static_cast<unsigned char>(c);
+    return static_cast<char>(UpperT ? std::toupper(uc) : std::tolower(uc));
+}
+
+template <bool UpperT>
+inline void convert_case_scalar(char* data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        data[i] = convert_case<UpperT>(data[i]);
+    }
+}
+
+#if defined(LUD_SIMD_DISPATCH)
+// ASCII bytes are positive so signed compares are fine for the range checks below
+template <bool UpperT>
+LUD_TARGET("sse2") inline void convert_case_sse2(char* data, size_t size)
+{
+    constexpr char first = UpperT ? 'a' : 'A';
+    constexpr char last = UpperT ? 'z' : 'Z';
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        auto* p = reinterpret_cast<__m128i*>(data + i);
+        const __m128i block = _mm_loadu_si128(p);
+        if (_mm_movemask_epi8(block) != 0)
+        {
+            convert_case_scalar<UpperT>(data + i, 16);
+            continue;
+        }
+        const __m128i in_range = _mm_and_si128(
+            _mm_cmpgt_epi8(block, _mm_set1_epi8(first - 1)),
+            _mm_cmplt_epi8(block, _mm_set1_epi8(last + 1))
+        );
+        _mm_storeu_si128(p, _mm_xor_si128(block, _mm_and_si128(in_range, _mm_set1_epi8(0x20))));
+    }
+    convert_case_scalar<UpperT>(data + i, size - i);
+}
+
+template <bool UpperT>
+LUD_TARGET("avx2") inline void convert_case_avx2(char* data, size_t size)
+{
+    constexpr char first = UpperT ? 'a' : 'A';
+    constexpr char last = UpperT ? 'z' : 'Z';
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        auto* p = reinterpret_cast<__m256i*>(data + i);
+        const __m256i block = _mm256_loadu_si256(p);
+        if (_mm256_movemask_epi8(block) != 0)
+        {
+            convert_case_scalar<UpperT>(data + i, 32);
+            continue;
+        }
+        const __m256i in_range = _mm256_and_si256(
+            _mm256_cmpgt_epi8(block, _mm256_set1_epi8(first - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(last + 1), block)
+        );
+        _mm256_storeu_si256(p, _mm256_xor_si256(block, _mm256_and_si256(in_range, _mm256_set1_epi8(0x20))));
+    }
+    convert_case_scalar<UpperT>(data + i, size - i);
+}
+#endif
+
+/**
+ * @brief changes the case of size chars starting at data, a vector at a time,
+ *        vectors containing non ASCII bytes are handed to the locale one char at a time
+ *
+ * @tparam UpperT true to convert to upper case, false for lower case
+ */
+template <bool UpperT>
+inline void convert_case(char* data, size_t size)
+{
+    static const auto kernel = dispatch_table<void (*)(char*, size_t)>{
+        .scalar = convert_case_scalar<UpperT>,
+#if defined(LUD_SIMD_DISPATCH)
+        .sse2 = convert_case_sse2<UpperT>,
+        .avx2 = convert_case_avx2<UpperT>,
+#endif
+    }.select();
+    kernel(data, size);
+}
+
+inline size_t find_in_set_scalar(const uint8_t*, const uint64_t* bits, const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        const auto uc = static_cast<unsigned char>(data[i]);
+        if ((bits[uc >> 6] >> (uc & 63)) & 1)
+        {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+#if defined(LUD_SIMD_DISPATCH)
+// rows[0..15] hold the bits of the bytes below 0x80 and rows[16..31] the ones above, indexed by the low nibble,
+// the high nibble picks the bit, so a byte is in the set when row[lo] & (1 << hi % 8) is set
+LUD_TARGET("ssse3") inline size_t find_in_set_ssse3(const uint8_t* rows, const uint64_t* bits, const char* data, size_t size)
+{
+    const __m128i rows_low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows));
+    const __m128i rows_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + 16));
+    const __m128i bit_table = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i lo = _mm_and_si128(block, nibble);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(block, 4), nibble);
+        const __m128i high_half = _mm_cmplt_epi8(block, _mm_setzero_si128());
+        const __m128i row = _mm_or_si128(
+            _mm_andnot_si128(high_half, _mm_shuffle_epi8(rows_low, lo)),
+            _mm_and_si128(high_half, _mm_shuffle_epi8(rows_high, lo))
+        );
+        const __m128i bit = _mm_shuffle_epi8(bit_table, hi);
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), bit)));
+        if (mask != 0)
+        {
+            return i + std::countr_zero(mask);
+        }
+    }
+    const size_t found = find_in_set_scalar(rows, bits, data + i, size - i);
+    return found == std::string_view::npos ? found : i + found;
+}
+
+LUD_TARGET("avx2") inline size_t find_in_set_avx2(const uint8_t* rows, const uint64_t* bits, const char* data, size_t size)
+{
+    const __m256i rows_low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rows)));
+    const __m256i rows_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + 16)));
+    const __m256i bit_table = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128
+    );
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i lo = _mm256_and_si256(block, nibble);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble);
+        // bytes >= 0x80 are negative, blendv takes those from the high rows
+        const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(rows_low, lo), _mm256_shuffle_epi8(rows_high, lo), block);
+        const __m256i bit = _mm256_shuffle_epi8(bit_table, hi);
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit)));
+        if (mask != 0)
+        {
+            return i + std::countr_zero(mask);
+        }
+    }
+    const size_t found = find_in_set_scalar(rows, bits, data + i, size - i);
+    return found == std::string_view::npos ? found : i + found;
+}
+#endif
+
+/**
+ * @brief calls f with the position of the first char of every word in str, words being separated by whitespace
+ */
+template <typename F>
+void scan_word_starts(const std::string_view str, F&& f)
+{
+    const char* data = str.data();
+    // the start of the string counts as whitespace
+    uint32_t prev_ws = 1;
+    size_t i = 0;
+    for (; i + scan_block_size <= str.size(); i += scan_block_size)
+    {
+        const uint32_t ws = whitespace_block_mask(data + i);
+        uint32_t starts = ~ws & ((ws << 1) | prev_ws) & scan_block_full_mask;
+        prev_ws = (ws >> (scan_block_size - 1)) & 1;
+        while (starts != 0)
+        {
+            f(i + std::countr_zero(starts));
+            starts &= starts - 1;
+        }
+    }
+    for (; i < str.size(); i++)
+    {
+        const bool ws = is_whitespace(data[i]);
+        if (!ws && prev_ws)
+        {
+            f(i);
+        }
+        prev_ws = ws;
+    }
+}
+
+
+/**
+ * @brief amount of non overlapping occurrences of pattern in str
+ */
+inline size_t count_matches(const std::string_view str, const std::string_view pattern)
+{
+    size_t count = 0;
+    for (size_t pos = str.find(pattern); pos != std::string_view::npos; pos = str.find(pattern, pos + pattern.size()))
+    {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief copies str into out replacing every occurrence of pattern, out must have room for the result
+ *
+ * @return pointer past the last written char
+ */
+inline char* replace_copy(char* out, const std::string_view str, const std::string_view pattern, const std::string_view replacement)
+{
+    using TraitsT = std::char_traits<char>;
+    size_t read = 0;
+    for (size_t pos = str.find(pattern); pos != std::string_view::npos; pos = str.find(pattern, read))
+    {
+        TraitsT::copy(out, str.data() + read, pos - read);
+        out += pos - read;
+        TraitsT::copy(out, replacement.data(), replacement.size());
+        out += replacement.size();
+        read = pos + pattern.size();
+    }
+    TraitsT::copy(out, str.data() + read, str.size() - read);
+    return out + (str.size() - read);
+}
+
+inline bool overlaps(const std::string_view a, const std::string_view b)
+{
+    const std::less<const char*> less;
+    return !a.empty() && !b.empty() && less(a.data(), b.data() + b.size()) && less(b.data(), a.data() + a.size());
+}
+
+/**
+ * @brief appends count chars to out, written by write(char*) straight into the grown buffer
+ */
+template <typename F>
+std::string& append_overwrite(std::string& out, size_t count, F&& write)
+{
+    const size_t offset = out.size();
+    // libstdc++ 12 passes the grown capacity as the size, so the final size is returned instead
+    out.resize_and_overwrite(offset + count, [&](char* buf, size_t) {
+        write(buf + offset);
+        return offset + count;
+    });
+    return out;
+}
+
+template <typename F>
+std::span<char> span_overwrite(std::span<char> out, size_t count, F&& write)
+{
+    if (out.size() < count)
+    {
+        throw std::length_error("output span too small");
+    }
+    write(out.data());
+    return out.first(count);
+}
+
+/**
+ * @brief writes str through out a chunk at a time, each chunk transformed in a local buffer by f(char*, size)
+ */
+template <typename OutT, typename F>
+OutT transform_chunks(OutT out, const std::string_view str, F&& f)
+{
+    std::array<char, 512> buf;
+    for (size_t i = 0; i < str.size(); i += buf.size())
+    {
+        const size_t count = std::min(buf.size(), str.size() - i);
+        std::char_traits<char>::copy(buf.data(), str.data() + i, count);
+        f(buf.data(), count);
+        out = std::copy(buf.data(), buf.data() + count, out);
+    }
+    return out;
+}
+
+inline void copy_title(char* out, const std::string_view str)
+{
+    std::char_traits<char>::copy(out, str.data(), str.size());
+    scan_word_starts(std::string_view(out, str.size()), [&](size_t idx) {
+        out[idx] = convert_case<true>(out[idx]);
+    });
+}
+
+inline void copy_capitalized(char* out, const std::string_view str)
+{
+    std::char_traits<char>::copy(out, str.data(), str.size());
+    if (!str.empty())
+    {
+        out[0] = convert_case<true>(out[0]);
+    }
+}
+
+inline size_t replaced_size(const std::string_view str, const std::string_view pattern, const std::string_view replacement)
+{
+    const size_t count = detail::count_matches(str, pattern);
+    return str.size() - count * pattern.size() + count * replacement.size();
+}
+
+
+constexpr bool is_digit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+/**
+ * @brief checks that the 8 bytes loaded in chunk are all ascii digits
+ */
+constexpr bool is_eight_digits(uint64_t chunk)
+{
+    return ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+/**
+ * @brief value of 8 ascii digits loaded little endian in chunk, using 3 multiplications
+ */
+constexpr uint64_t parse_eight_digits(uint64_t chunk)
+{
+    chunk -= 0x3030303030303030;
+    chunk = (chunk * 10) + (chunk >> 8);
+    return (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) + (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+}
+
+/**
+ * @brief parses a run of at most 19 digits, which always fits in an uint64_t, 8 digits at a time
+ *
+ * @return false if there is anything else than digits
+ */
+constexpr bool parse_short_digits(const char* p, const char* end, uint64_t& value)
+{
+    if !consteval
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            while (end - p >= 8)
+            {
+                uint64_t chunk;
+                std::memcpy(&chunk, p, sizeof(chunk));
+                if (!is_eight_digits(chunk))
+                {
+                    return false;
+                }
+                value = value * 100000000 + parse_eight_digits(chunk);
+                p += 8;
+            }
+        }
+    }
+    for (; p != end; ++p)
+    {
+        if (!is_digit(*p))
+        {
+            return false;
+        }
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+    }
+    return true;
+}
+
+/**
+ * @brief same as parse_short_digits for runs of any length, leading zeros are skipped and overflow is checked
+ */
+constexpr bool parse_long_digits(const char* p, const char* end, uint64_t& value)
+{
+    while (p != end && *p == '0')
+    {
+        ++p;
+    }
+    if (end - p <= 19)
+    {
+        return parse_short_digits(p, end, value);
+    }
+    // 20 significant digits might still fit, more never do
+    if (end - p > 20 || !parse_short_digits(p, end - 1, value) || !is_digit(end[-1]))
+    {
+        return false;
+    }
+    const auto digit = static_cast<uint64_t>(end[-1] - '0');
+    if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+    {
+        return false;
+    }
+    value = value * 10 + digit;
+    return true;
+}
+
+/**
+ * @brief base 10 parse with the exact same rules as std::from_chars + the full match check done by is_num:
+ *        optional '-' only for signed types, at least one digit, no trailing chars, fails on overflow
+ *
+ * @return false if str is not a number representable by N, out is left untouched in that case
+ */
+template <typename N>
+constexpr bool narrow_integer(uint64_t value, bool negative, N& out);
+
+template <typename N>
+constexpr bool parse_decimal(const std::string_view str, N& out)
+{
+    static_assert(sizeof(N) <= sizeof(uint64_t));
+    const char* p = str.data();
+    const char* const end = p + str.size();
+
+    bool negative = false;
+    if constexpr (std::is_signed_v<N>)
+    {
+        if (p != end && *p == '-')
+        {
+            negative = true;
+            ++p;
+        }
+    }
+    if (p == end)
+    {
+        return false;
+    }
+
+    uint64_t value = 0;
+    // short fields are the common case, keep them on the path without overflow checks
+    const bool ok = end - p <= 19 ? parse_short_digits(p, end, value) : parse_long_digits(p, end, value);
+    if (!ok)
+    {
+        return false;
+    }
+    return narrow_integer(value, negative, out);
+}
+
+/**
+ * @brief stores the magnitude value with the given sign in out if it is representable by N
+ */
+template <typename N>
+constexpr bool narrow_integer(uint64_t value, bool negative, N& out)
+{
+    using UnsignedT = std::make_unsigned_t<N>;
+    constexpr auto max = static_cast<uint64_t>(std::numeric_limits<N>::max());
+    if constexpr (std::is_signed_v<N>)
+    {
+        if (negative)
+        {
+            if (value > max + 1)
+            {
+                return false;
+            }
+            out = static_cast<N>(static_cast<UnsignedT>(0 - static_cast<UnsignedT>(value)));
+            return true;
+        }
+    }
+    if (value > max)
+    {
+        return false;
+    }
+    out = static_cast<N>(value);
+    return true;
+}
+
+constexpr int digit_value(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'z')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'Z')
+    {
+        return c - 'A' + 10;
+    }
+    return 36;
+}
+
+/**
+ * @brief std::from_chars for any base usable in constant expressions, same rules as parse_decimal
+ */
+template <typename N>
+constexpr bool parse_integer_generic(const std::string_view str, int base, N& out)
+{
+    size_t i = 0;
+    bool negative = false;
+    if constexpr (std::is_signed_v<N>)
+    {
+        if (!str.empty() && str[0] == '-')
+        {
+            negative = true;
+            i++;
+        }
+    }
+    if (i == str.size())
+    {
+        return false;
+    }
+    uint64_t value = 0;
+    const auto ubase = static_cast<uint64_t>(base);
+    for (; i < str.size(); i++)
+    {
+        const auto digit = static_cast<uint64_t>(digit_value(str[i]));
+        if (digit >= ubase || value > (std::numeric_limits<uint64_t>::max() - digit) / ubase)
+        {
+            return false;
+        }
+        value = value * ubase + digit;
+    }
+    return narrow_integer(value, negative, out);
+}
+
+
+/**
+ * @brief is_num without the optional, for the hot loops that already have somewhere to write to
+ */
+template <typename N>
+bool parse_number(const std::string_view str, N& out)
+{
+    if constexpr (std::is_integral_v<N> && sizeof(N) <= sizeof(uint64_t))
+    {
+        return parse_decimal(Strip(str), out);
+    }
+    else
+    {
+        const auto res = is_num<N>(str);
+        if (!res)
+        {
+            return false;
+        }
+        out = *res;
+        return true;
+    }
+}
+
+// "00" "01" ... "99"
+inline constexpr std::array<char, 200> digit_pairs = [] {
+    std::array<char, 200> pairs{};
+    for (size_t i = 0; i < 100; i++)
+    {
+        pairs[i * 2] = static_cast<char>('0' + i / 10);
+        pairs[i * 2 + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}();
+
+constexpr size_t count_digits(uint64_t value)
+{
+    constexpr std::array<uint64_t, 20> powers = [] {
+        std::array<uint64_t, 20> res{};
+        uint64_t power = 1;
+        for (auto& p : res)
+        {
+            p = power;
+            power *= 10;
+        }
+        return res;
+    }();
+    value |= 1;
+    // log10(2) ~ 1233 / 4096, the bit width gives the digit count or one less
+    const size_t guess = (std::bit_width(value) * 1233) >> 12;
+    return guess + (value >= powers[guess]);
+}
+
+/**
+ * @brief writes the digits of value so they end at end, two at a time
+ */
+constexpr void write_digits(char* end, uint64_t value)
+{
+    while (value >= 100)
+    {
+        const size_t idx = (value % 100) * 2;
+        value /= 100;
+        *--end = digit_pairs[idx + 1];
+        *--end = digit_pairs[idx];
+    }
+    if (value >= 10)
+    {
+        *--end = digit_pairs[value * 2 + 1];
+        *--end = digit_pairs[value * 2];
+    }
+    else
+    {
+        *--end = static_cast<char>('0' + value);
+    }
+}
+
+// sign and magnitude of an integer that fits in 64 bits
+template <typename N>
+constexpr std::pair<bool, uint64_t> integer_magnitude(N value)
+{
+    if constexpr (std::is_signed_v<N>)
+    {
+        if (value < 0)
+        {
+            return {true, uint64_t{0} - static_cast<uint64_t>(value)};
+        }
+    }
+    return {false, static_cast<uint64_t>(value)};
+}
+
+// wider integers go through std::to_chars, this fits any 128 bit one
+inline constexpr size_t wide_integer_chars = 41;
+
+template <typename N>
+constexpr size_t integer_size(N value)
+{
+    if constexpr (sizeof(N) <= sizeof(uint64_t))
+    {
+        const auto [negative, magnitude] = integer_magnitude(value);
+        return negative + count_digits(magnitude);
+    }
+    else
+    {
+        std::array<char, wide_integer_chars> buf;
+        return static_cast<size_t>(std::to_chars(buf.data(), buf.data() + buf.size(), value).ptr - buf.data());
+    }
+}
+
+/**
+ * @brief writes value at out, which must have room for integer_size(value) chars
+ *
+ * @return pointer past the last written char
+ */
+template <typename N>
+constexpr char* write_integer(char* out, N value)
+{
+    if constexpr (sizeof(N) <= sizeof(uint64_t))
+    {
+        const auto [negative, magnitude] = integer_magnitude(value);
+        if (negative)
+        {
+            *out++ = '-';
+        }
+        char* end = out + count_digits(magnitude);
+        write_digits(end, magnitude);
+        return end;
+    }
+    else
+    {
+        return std::to_chars(out, out + wide_integer_chars, value).ptr;
+    }
+}
+
+/**
+ * @brief upper bound of the shortest round trip text of N: sign, digits, point, exponent mark, sign and digits
+ */
+template <typename N>
+inline constexpr size_t max_real_chars = 4 + std::numeric_limits<N>::max_digits10
+                                       + count_digits(std::max(std::numeric_limits<N>::max_exponent10, -std::numeric_limits<N>::min_exponent10));
+
+template <typename N>
+size_t number_size_bound(N value)
+{
+    if constexpr (std::is_integral_v<N>)
+    {
+        return integer_size(value);
+    }
+    else
+    {
+        return max_real_chars<N>;
+    }
+}
+
+template <typename N>
+char* write_number(char* out, N value)
+{
+    if constexpr (std::is_integral_v<N>)
+    {
+        return write_integer(out, value);
+    }
+    else
+    {
+        return std::to_chars(out, out + max_real_chars<N>, value).ptr;
+    }
+}
+
+inline constexpr std::string_view hex_digits_lower = "0123456789abcdef";
+inline constexpr std::string_view hex_digits_upper = "0123456789ABCDEF";
+
+// writes 2 * size chars
+using hex_encode_fn = void (*)(const uint8_t* data, size_t size, char* out, bool upper);
+// reads an even amount of chars and writes half as many bytes, returns the offset of the first bad char or npos
+using hex_decode_fn = size_t (*)(const char* str, size_t size, uint8_t* out);
+
+inline void hex_encode_scalar(const uint8_t* data, size_t size, char* out, bool upper)
+{
+    const char* digits = upper ? hex_digits_upper.data() : hex_digits_lower.data();
+    for (size_t i = 0; i < size; i++)
+    {
+        out[2 * i] = digits[data[i] >> 4];
+        out[2 * i + 1] = digits[data[i] & 0x0F];
+    }
+}
+
+inline size_t hex_decode_scalar(const char* str, size_t size, uint8_t* out)
+{
+    for (size_t i = 0; i < size; i += 2)
+    {
+        const int hi = digit_value(str[i]);
+        const int lo = digit_value(str[i + 1]);
+        if (hi >= 16 || lo >= 16)
+        {
+            return hi >= 16 ? i : i + 1;
+        }
+        out[i / 2] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return std::string_view::npos;
+}
+
+inline constexpr std::string_view base64_alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// value of every base64 char, 64 for the rest
+inline constexpr std::array<uint8_t, 256> base64_table = [] {
+    std::array<uint8_t, 256> table{};
+    table.fill(64);
+    for (size_t i = 0; i < base64_alphabet.size(); i++)
+    {
+        table[static_cast<unsigned char>(base64_alphabet[i])] = static_cast<uint8_t>(i);
+    }
+    return table;
+}();
+
+// writes 4 chars per started group of 3 bytes, padding included
+using base64_encode_fn = void (*)(const uint8_t* data, size_t size, char* out);
+// reads size chars without padding, size % 4 != 1, returns the offset of the first bad char or npos
+using base64_decode_fn = size_t (*)(const char* str, size_t size, uint8_t* out);
+
+inline void base64_encode_scalar(const uint8_t* data, size_t size, char* out)
+{
+    const char* alphabet = base64_alphabet.data();
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3)
+    {
+        const uint32_t group = (uint32_t{data[i]} << 16) | (uint32_t{data[i + 1]} << 8) | data[i + 2];
+        *out++ = alphabet[group >> 18];
+        *out++ = alphabet[(group >> 12) & 63];
+        *out++ = alphabet[(group >> 6) & 63];
+        *out++ = alphabet[group & 63];
+    }
+    if (i < size)
+    {
+        const bool two = i + 2 == size;
+        const uint32_t group = (uint32_t{data[i]} << 16) | (two ? uint32_t{data[i + 1]} << 8 : 0);
+        *out++ = alphabet[group >> 18];
+        *out++ = alphabet[(group >> 12) & 63];
+        *out++ = two ? alphabet[(group >> 6) & 63] : '=';
+        *out++ = '=';
+    }
+}
+
+inline size_t base64_decode_scalar(const char* str, size_t size, uint8_t* out)
+{
+    uint32_t group = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        const uint8_t value = base64_table[static_cast<unsigned char>(str[i])];
+        if (value == 64)
+        {
+            return i;
+        }
+        group = (group << 6) | value;
+        if (i % 4 == 3)
+        {
+            *out++ = static_cast<uint8_t>(group >> 16);
+            *out++ = static_cast<uint8_t>(group >> 8);
+            *out++ = static_cast<uint8_t>(group);
+        }
+    }
+    // 2 or 3 chars left give 1 or 2 bytes, the bits past them are ignored
+    if (size % 4 == 2)
+    {
+        *out = static_cast<uint8_t>(group >> 4);
+    }
+    else if (size % 4 == 3)
+    {
+        *out++ = static_cast<uint8_t>(group >> 10);
+        *out = static_cast<uint8_t>(group >> 2);
+    }
+    return std::string_view::npos;
+}
+
+#if defined(LUD_SIMD_DISPATCH)
+LUD_TARGET("ssse3") inline void hex_encode_ssse3(const uint8_t* data, size_t size, char* out, bool upper)
+{
+    const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(upper ? hex_digits_upper.data() : hex_digits_lower.data()));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(block, 4), nibble));
+        const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(block, nibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    hex_encode_scalar(data + i, size - i, out + 2 * i, upper);
+}
+
+// nibble of every digit in block, valid gets 0xFF where block has a digit
+LUD_TARGET("ssse3") inline __m128i hex_nibbles_ssse3(__m128i block, __m128i& valid)
+{
+    const __m128i digit = _mm_sub_epi8(block, _mm_set1_epi8('0'));
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(block, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    // unsigned x <= n is min(x, n) == x
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    valid = _mm_or_si128(is_digit, is_letter);
+    return _mm_or_si128(
+        _mm_and_si128(is_digit, digit),
+        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10)))
+    );
+}
+
+LUD_TARGET("ssse3") inline size_t hex_decode_ssse3(const char* str, size_t size, uint8_t* out)
+{
+    // the high nibble comes first, maddubs adds hi * 16 + lo for every pair
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m128i valid_a;
+        __m128i valid_b;
+        const __m128i a = hex_nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i)), valid_a);
+        const __m128i b = hex_nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i + 16)), valid_b);
+        const uint32_t valid = static_cast<uint32_t>(_mm_movemask_epi8(valid_a)) | (static_cast<uint32_t>(_mm_movemask_epi8(valid_b)) << 16);
+        if (valid != 0xFFFFFFFF)
+        {
+            return i + std::countr_one(valid);
+        }
+        const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), bytes);
+    }
+    const size_t bad = hex_decode_scalar(str + i, size - i, out + i / 2);
+    return bad == std::string_view::npos ? bad : i + bad;
+}
+
+// Muła and Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions", with 16 byte vectors
+LUD_TARGET("ssse3") inline void base64_encode_ssse3(const uint8_t* data, size_t size, char* out)
+{
+    const __m128i spread = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    size_t i = 0;
+    // 12 bytes are used of the 16 loaded
+    for (; i + 16 <= size; i += 12)
+    {
+        const __m128i block = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), spread);
+        // every 32 bit lane holds 3 bytes, the multiplies move each 6 bit index into its own byte
+        const __m128i ac = _mm_mulhi_epu16(_mm_and_si128(block, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        const __m128i bd = _mm_mullo_epi16(_mm_and_si128(block, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(ac, bd);
+        // 0..25 map to 13, 26..51 to 0, 52..61 to 1..10, 62 and 63 to 11 and 12, then the shift of that range is added
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        const __m128i chars = _mm_add_epi8(indices, _mm_shuffle_epi8(shift, range));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 3 * 4), chars);
+    }
+    base64_encode_scalar(data + i, size - i, out + i / 3 * 4);
+}
+
+LUD_TARGET("ssse3") inline size_t base64_decode_ssse3(const char* str, size_t size, uint8_t* out)
+{
+    // a char is valid when the bits of its low and high nibble rows do not meet
+    const __m128i rows_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i rows_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    // added to a char to get its value, by high nibble, '/' is moved off the '+' entry
+    const __m128i roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    // 16 bytes are stored for the 12 decoded, the chars left after the block make room for the rest
+    for (; i + 24 <= size; i += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+        const __m128i hi = _mm_and_si128(_mm_srli_epi32(block, 4), nibble);
+        const __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(rows_lo, _mm_and_si128(block, nibble)), _mm_shuffle_epi8(rows_hi, hi));
+        const auto bad = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128()))) ^ 0xFFFF;
+        if (bad != 0)
+        {
+            return i + std::countr_zero(bad);
+        }
+        const __m128i is_slash = _mm_cmpeq_epi8(block, _mm_set1_epi8('/'));
+        const __m128i values = _mm_add_epi8(block, _mm_shuffle_epi8(roll, _mm_add_epi8(is_slash, hi)));
+        // 4 values of 6 bits to 2 of 12 bits to 1 of 24 bits per 32 bit lane, then the 3 bytes are moved to the front
+        const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 4 * 3), _mm_shuffle_epi8(groups, pack));
+    }
+    const size_t bad = base64_decode_scalar(str + i, size - i, out + i / 4 * 3);
+    return bad == std::string_view::npos ? bad : i + bad;
+}
+#endif
+
+} // namespace Lud::detail
+
+template <Lud::integer_type N>
+constexpr std::optional<N> Lud::is_num(const std::string_view sv, int base /*=10*/)
+{
+    // house keeping since from chars does not recognize leading plus sign and leading whitespace
+    auto check = Strip(sv);
+    if constexpr (sizeof(N) <= sizeof(uint64_t))
+    {
+        N val{};
+        if (base == 10)
+        {
+            if (!detail::parse_decimal(check, val))
+            {
+                return std::nullopt;
+            }
+            return val;
+        }
+        // std::from_chars is not usable in constant expressions
+        if consteval
+        {
+            if (!detail::parse_integer_generic(check, base, val))
+            {
+                return std::nullopt;
+            }
+            return val;
+        }
+    }
+    // inplace::RemovePrefix(check, "+");
+    // switch (base)
+    // {
+    // case 16:
+    //     inplace::RemovePrefix(check, "0X");
+    //     break;
+    // case 2:
+    //     inplace::RemovePrefix(check, "0B");
+    //     break;
+    // case 8:
+    //     inplace::RemovePrefix(check, "0O");
+    //     inplace::RemovePrefix(check, "0");
     //     break;
     // default:
     //     break;
     // }
 
-    N val{};
-    const auto first = check.data();
-    const auto last = first + check.size();
-    const auto res = std::from_chars(first, last, val, base);
-    if (res.ec == std::errc::invalid_argument || res.ec == std::errc::result_out_of_range)
+    N val{};
+    const auto first = check.data();
+    const auto last = first + check.size();
+    const auto res = std::from_chars(first, last, val, base);
+    if (res.ec == std::errc::invalid_argument || res.ec == std::errc::result_out_of_range)
+    {
+        return std::nullopt;
+    }
+    if (res.ptr != last)
+    {
+        return std::nullopt;
+    }
+    return val;
+}
+
+template <Lud::integer_type N, int BaseT>
+constexpr std::optional<N> Lud::is_num(const std::string_view sv)
+{
+    if constexpr (BaseT == 10 && sizeof(N) <= sizeof(uint64_t))
+    {
+        N val{};
+        if (!detail::parse_decimal(Strip(sv), val))
+        {
+            return std::nullopt;
+        }
+        return val;
+    }
+    else
+    {
+        return is_num<N>(sv, BaseT);
+    }
+}
+
+template <Lud::real_type N>
+std::optional<N> Lud::is_num(const std::string_view sv, const std::chars_format fmt /*=std::chars_format::general)*/)
+{
+    auto check = Strip(sv);
+    // if (std::to_underlying(fmt) & std::to_underlying(std::chars_format::hex))
+    // {
+    //     inplace::RemovePrefix(check, "0X");
+    // }
+    // else
+    // {
+    //     inplace::RemovePrefix(check, "+");
+    // }
+
+    N val{};
+    const auto first = check.data();
+    const auto last = first + check.size();
+    const auto res = std::from_chars(first, last, val, fmt);
+    if (res.ec == std::errc::invalid_argument || res.ec == std::errc::result_out_of_range)
+    {
+        return std::nullopt;
+    }
+    if (res.ptr != last)
+    {
+        return std::nullopt;
+    }
+    return val;
+}
+
+template <Lud::real_type N>
+std::optional<N> Lud::ParseQuantity(const std::string_view sv, const quantity_options& options)
+{
+    const auto str = Strip(sv);
+    if (str.empty())
+    {
+        return std::nullopt;
+    }
+
+    // units go first so suffixes like "km/h" or "%RH" are not taken for fractions or percentages
+    const quantity_unit* unit = nullptr;
+    for (const auto& candidate : options.units)
+    {
+        if (candidate.suffix.size() < str.size() && str.ends_with(candidate.suffix) && (!unit || candidate.suffix.size() > unit->suffix.size()))
+        {
+            unit = &candidate;
+        }
+    }
+    if (unit)
+    {
+        // "nan" ends in the "n" prefix, so a failed unit parse still gets a chance as anything else
+        if (const auto num = is_num<N>(str.substr(0, str.size() - unit->suffix.size())))
+        {
+            return *num * static_cast<N>(unit->scale);
+        }
+    }
+
+    if (str.back() == '%')
+    {
+        if (!options.percentage)
+        {
+            return std::nullopt;
+        }
+        const auto num = is_num<N>(str.substr(0, str.size() - 1));
+        if (!num)
+        {
+            return std::nullopt;
+        }
+        return *num / N{100};
+    }
+
+    if (const size_t slash = str.find('/'); slash != std::string_view::npos)
+    {
+        if (!options.fraction)
+        {
+            return std::nullopt;
+        }
+        const auto numerator = is_num<N>(str.substr(0, slash));
+        const auto denominator = is_num<N>(str.substr(slash + 1));
+        if (!(numerator && denominator))
+        {
+            return std::nullopt;
+        }
+        if (*denominator == 0)
+        {
+            return std::numeric_limits<N>::quiet_NaN();
+        }
+        return *numerator / *denominator;
+    }
+
+    if (!options.plain)
+    {
+        return std::nullopt;
+    }
+    return is_num<N>(str);
+}
+
+template <Lud::real_type N>
+std::optional<N> Lud::is_fraction(const std::string_view sv)
+{
+    return ParseQuantity<N>(sv, {.plain = false, .fraction = true, .percentage = false});
+}
+
+template <Lud::real_type N>
+std::optional<N> Lud::is_percentage(const std::string_view sv)
+{
+    return ParseQuantity<N>(sv, {.plain = false, .fraction = false, .percentage = true});
+}
+
+template <Lud::string_container Container>
+std::string Lud::Join(const Container& container, const std::string_view delim)
+{
+    return Join(container.begin(), container.end(), delim);
+}
+
+template <Lud::string_container Container>
+std::string Lud::Join(const Container& container, char delim)
+{
+    return Join(container.begin(), container.end(), delim);
+}
+
+template <std::input_iterator T>
+std::string Lud::Join(T first, T last, const std::string_view delim)
+{
+    std::string res;
+    JoinTo(res, first, last, delim);
+    return res;
+}
+
+template <std::input_iterator T>
+std::string Lud::Join(T first, T last, char delim)
+{
+    std::string res;
+    JoinTo(res, first, last, std::string_view(&delim, 1));
+    return res;
+}
+
+template <Lud::string_container Container>
+std::string& Lud::JoinTo(std::string& out, const Container& container, const std::string_view delim)
+{
+    return JoinTo(out, std::ranges::begin(container), std::ranges::end(container), delim);
+}
+
+template <Lud::string_container Container>
+std::string& Lud::JoinTo(std::string& out, const Container& container, char delim)
+{
+    return JoinTo(out, std::ranges::begin(container), std::ranges::end(container), std::string_view(&delim, 1));
+}
+
+template <std::input_iterator T>
+std::string& Lud::JoinTo(std::string& out, T first, T last, const std::string_view delim)
+{
+    // sizing first dereferences every element twice, fine for references and views but not for made up strings
+    using reference = std::iter_reference_t<T>;
+    constexpr bool cheap_elements = std::is_lvalue_reference_v<reference> || std::is_trivially_copyable_v<std::remove_cvref_t<reference>>;
+    if constexpr (std::forward_iterator<T> && cheap_elements)
+    {
+        size_t count = 0;
+        size_t total = 0;
+        for (auto it = first; it != last; ++it)
+        {
+            total += std::string_view(*it).size();
+            count++;
+        }
+        if (count == 0)
+        {
+            return out;
+        }
+        total += (count - 1) * delim.size();
+
+        const size_t offset = out.size();
+        // libstdc++ 12 passes the grown capacity as the size, so the written size is returned instead
+        out.resize_and_overwrite(offset + total, [&](char* buf, size_t) {
+            return static_cast<size_t>(JoinTo(buf + offset, first, last, delim) - buf);
+        });
+    }
+    else
+    {
+        JoinTo(std::back_inserter(out), first, last, delim);
+    }
+    return out;
+}
+
+template <std::input_iterator T>
+std::string& Lud::JoinTo(std::string& out, T first, T last, char delim)
+{
+    return JoinTo(out, first, last, std::string_view(&delim, 1));
+}
+
+template <std::output_iterator<char> OutT, std::input_iterator T>
+OutT Lud::JoinTo(OutT out, T first, T last, const std::string_view delim)
+{
+    bool first_elem = true;
+    for (auto it = first; it != last; ++it)
+    {
+        if (!first_elem)
+        {
+            out = std::ranges::copy(delim, out).out;
+        }
+        first_elem = false;
+        // *it might be a temporary string
+        auto&& elem = *it;
+        out = std::ranges::copy(std::string_view(elem), out).out;
+    }
+    return out;
+}
+
+template <std::output_iterator<char> OutT, std::input_iterator T>
+OutT Lud::JoinTo(OutT out, T first, T last, char delim)
+{
+    return JoinTo(out, first, last, std::string_view(&delim, 1));
+}
+
+template <Lud::integer_type N>
+std::string Lud::FormatInteger(N value)
+{
+    std::string res;
+    FormatInteger(res, value);
+    return res;
+}
+
+template <Lud::integer_type N>
+std::string& Lud::FormatInteger(std::string& out, N value)
+{
+    return detail::append_overwrite(out, detail::integer_size(value), [&](char* buf) {
+        detail::write_integer(buf, value);
+    });
+}
+
+template <Lud::integer_type N>
+std::span<char> Lud::FormatInteger(std::span<char> out, N value)
+{
+    return detail::span_overwrite(out, detail::integer_size(value), [&](char* buf) {
+        detail::write_integer(buf, value);
+    });
+}
+
+template <Lud::real_type N>
+std::string Lud::FormatReal(N value)
+{
+    std::string res;
+    FormatReal(res, value);
+    return res;
+}
+
+template <Lud::real_type N>
+std::string& Lud::FormatReal(std::string& out, N value)
+{
+    const size_t offset = out.size();
+    // libstdc++ 12 passes the grown capacity as the size, so the final size is returned instead
+    out.resize_and_overwrite(offset + detail::max_real_chars<N>, [&](char* buf, size_t) {
+        return static_cast<size_t>(detail::write_number(buf + offset, value) - buf);
+    });
+    return out;
+}
+
+template <Lud::real_type N>
+std::span<char> Lud::FormatReal(std::span<char> out, N value)
+{
+    const auto [ptr, ec] = std::to_chars(out.data(), out.data() + out.size(), value);
+    if (ec != std::errc())
+    {
+        throw std::length_error("output span too small");
+    }
+    return out.first(static_cast<size_t>(ptr - out.data()));
+}
+
+template <Lud::real_type N>
+std::string Lud::FormatReal(N value, std::chars_format fmt, int precision)
+{
+    std::string res;
+    FormatReal(res, value, fmt, precision);
+    return res;
+}
+
+template <Lud::real_type N>
+std::string& Lud::FormatReal(std::string& out, N value, std::chars_format fmt, int precision)
+{
+    const size_t offset = out.size();
+    // fixed notation of big numbers has no useful bound, so the guess grows until it fits
+    size_t guess = detail::max_real_chars<N> + static_cast<size_t>(std::max(precision, 0));
+    bool written = false;
+    while (!written)
+    {
+        out.resize_and_overwrite(offset + guess, [&](char* buf, size_t) {
+            const auto [ptr, ec] = std::to_chars(buf + offset, buf + offset + guess, value, fmt, precision);
+            written = ec == std::errc();
+            return written ? static_cast<size_t>(ptr - buf) : offset;
+        });
+        guess *= 4;
+    }
+    return out;
+}
+
+template <Lud::range_of_numbers R>
+std::string Lud::JoinNumbers(const R& numbers, const std::string_view delim)
+{
+    std::string res;
+    JoinNumbersTo(res, numbers, delim);
+    return res;
+}
+
+template <Lud::range_of_numbers R>
+std::string Lud::JoinNumbers(const R& numbers, char delim)
+{
+    std::string res;
+    JoinNumbersTo(res, numbers, std::string_view(&delim, 1));
+    return res;
+}
+
+template <Lud::range_of_numbers R>
+std::string& Lud::JoinNumbersTo(std::string& out, const R& numbers, const std::string_view delim)
+{
+    if (detail::overlaps(out, delim))
+    {
+        return JoinNumbersTo(out, numbers, std::string(delim));
+    }
+    size_t count = 0;
+    size_t total = 0;
+    for (const auto value : numbers)
+    {
+        total += detail::number_size_bound(value);
+        count++;
+    }
+    if (count == 0)
+    {
+        return out;
+    }
+    total += (count - 1) * delim.size();
+
+    const size_t offset = out.size();
+    // libstdc++ 12 passes the grown capacity as the size, so the final size is returned instead
+    out.resize_and_overwrite(offset + total, [&](char* buf, size_t) {
+        char* p = buf + offset;
+        bool first_elem = true;
+        for (const auto value : numbers)
+        {
+            if (!first_elem)
+            {
+                std::char_traits<char>::copy(p, delim.data(), delim.size());
+                p += delim.size();
+            }
+            first_elem = false;
+            p = detail::write_number(p, value);
+        }
+        return static_cast<size_t>(p - buf);
+    });
+    return out;
+}
+
+template <Lud::range_of_numbers R>
+std::string& Lud::JoinNumbersTo(std::string& out, const R& numbers, char delim)
+{
+    return JoinNumbersTo(out, numbers, std::string_view(&delim, 1));
+}
+
+inline std::string Lud::HexEncode(std::span<const uint8_t> data, bool upper)
+{
+    std::string res;
+    HexEncode(res, data, upper);
+    return res;
+}
+
+inline std::string& Lud::HexEncode(std::string& out, std::span<const uint8_t> data, bool upper)
+{
+    static const auto kernel = dispatch_table<detail::hex_encode_fn>{
+        .scalar = detail::hex_encode_scalar,
+#if defined(LUD_SIMD_DISPATCH)
+        .ssse3 = detail::hex_encode_ssse3,
+#endif
+    }.select();
+    return detail::append_overwrite(out, data.size() * 2, [&](char* buf) {
+        kernel(data.data(), data.size(), buf, upper);
+    });
+}
+
+inline Lud::decode_result Lud::HexDecode(const std::string_view str, std::vector<uint8_t>& out)
+{
+    static const auto kernel = dispatch_table<detail::hex_decode_fn>{
+        .scalar = detail::hex_decode_scalar,
+#if defined(LUD_SIMD_DISPATCH)
+        .ssse3 = detail::hex_decode_ssse3,
+#endif
+    }.select();
+    const size_t offset = out.size();
+    const size_t count = str.size() / 2;
+    out.resize(offset + count);
+    size_t bad = kernel(str.data(), count * 2, out.data() + offset);
+    if (bad == std::string_view::npos && str.size() % 2 != 0)
+    {
+        bad = str.size() - 1;
+    }
+    if (bad != std::string_view::npos)
+    {
+        out.resize(offset);
+        return {.error_offset = bad};
+    }
+    return {.count = count};
+}
+
+inline std::string Lud::Base64Encode(std::span<const uint8_t> data)
+{
+    std::string res;
+    Base64Encode(res, data);
+    return res;
+}
+
+inline std::string& Lud::Base64Encode(std::string& out, std::span<const uint8_t> data)
+{
+    static const auto kernel = dispatch_table<detail::base64_encode_fn>{
+        .scalar = detail::base64_encode_scalar,
+#if defined(LUD_SIMD_DISPATCH)
+        .ssse3 = detail::base64_encode_ssse3,
+#endif
+    }.select();
+    return detail::append_overwrite(out, (data.size() + 2) / 3 * 4, [&](char* buf) {
+        kernel(data.data(), data.size(), buf);
+    });
+}
+
+inline Lud::decode_result Lud::Base64Decode(const std::string_view str, std::vector<uint8_t>& out)
+{
+    static const auto kernel = dispatch_table<detail::base64_decode_fn>{
+        .scalar = detail::base64_decode_scalar,
+#if defined(LUD_SIMD_DISPATCH)
+        .ssse3 = detail::base64_decode_ssse3,
+#endif
+    }.select();
+    size_t size = str.size();
+    if (size % 4 == 0 && size != 0 && str[size - 1] == '=')
+    {
+        size -= str[size - 2] == '=' ? 2 : 1;
+    }
+    // a lone char holds 6 bits, not enough for a byte
+    const size_t whole = size % 4 == 1 ? size - 1 : size;
+    const size_t count = whole / 4 * 3 + (whole % 4 == 0 ? 0 : whole % 4 - 1);
+
+    const size_t offset = out.size();
+    out.resize(offset + count);
+    size_t bad = kernel(str.data(), whole, out.data() + offset);
+    if (bad == std::string_view::npos && whole != size)
+    {
+        bad = whole;
+    }
+    if (bad != std::string_view::npos)
+    {
+        out.resize(offset);
+        return {.error_offset = bad};
+    }
+    return {.count = count};
+}
+
+constexpr std::string_view Lud::RemovePrefix(const std::string_view str, const std::string_view prefix)
+{
+
+    if (str.starts_with(prefix))
+    {
+        return str.substr(prefix.size());
+    }
+
+    return str;
+}
+
+constexpr std::string_view Lud::RemoveSuffix(const std::string_view str, const std::string_view suffix)
+{
+    if (str.ends_with(suffix))
+    {
+        return str.substr(0, str.size() - suffix.size());
+    }
+
+    return str;
+}
+
+inline std::string& Lud::inplace::RemovePrefix(std::string& str, const std::string_view prefix)
+{
+    if (str.starts_with(prefix))
+    {
+        str.erase(0, prefix.size());
+    }
+    return str;
+}
+
+inline std::string& Lud::inplace::RemoveSuffix(std::string& str, const std::string_view suffix)
+{
+    if (str.ends_with(suffix))
+    {
+        str.erase(str.size() - suffix.size());
+    }
+    return str;
+}
+
+template <Lud::range_of_string_view R>
+constexpr R Lud::Split(const std::string_view str, const std::string_view delim, size_t n)
+{
+    R r;
+    if (delim.empty())
+    {
+        std::inserter(r, r.end()) = str;
+        return r;
+    }
+    size_t next = str.find(delim);
+    std::string_view inner_str = str;
+    size_t count = 0;
+    while (next != std::string_view::npos && (n != count || n == 0))
+    {
+        // skips empty
+        if (next != 0)
+        {
+            std::inserter(r, r.end()) = inner_str.substr(0, next);
+            count++;
+        }
+        inner_str.remove_prefix(next + delim.size());
+        next = inner_str.find(delim);
+    }
+    if (!inner_str.empty())
+    {
+        std::inserter(r, r.end()) = inner_str;
+    }
+
+    return r;
+}
+template <Lud::range_of_string_view R>
+constexpr R Lud::Split(const std::string_view str, char delim, size_t n)
+{
+    R r;
+    size_t count = 0;
+    size_t token_begin = 0;
+    detail::scan_char(str, delim, [&](size_t pos) {
+        if (n != 0 && count == n)
+        {
+            return false;
+        }
+        // skips empty
+        if (pos != token_begin)
+        {
+            std::inserter(r, r.end()) = str.substr(token_begin, pos - token_begin);
+            count++;
+        }
+        token_begin = pos + 1;
+        return true;
+    });
+    if (token_begin < str.size())
     {
-        return std::nullopt;
+        std::inserter(r, r.end()) = str.substr(token_begin);
     }
-    if (res.ptr != last)
+
+    return r;
+}
+
+template <size_t SplitsT>
+constexpr Lud::static_vector<std::string_view, SplitsT + 1> Lud::SplitN(const std::string_view str, char delim)
+{
+    static_assert(SplitsT != 0, "SplitN needs a split limit");
+    return Split<static_vector<std::string_view, SplitsT + 1>>(str, delim, SplitsT);
+}
+
+template <size_t SplitsT>
+constexpr Lud::static_vector<std::string_view, SplitsT + 1> Lud::SplitN(const std::string_view str, const std::string_view delim)
+{
+    static_assert(SplitsT != 0, "SplitN needs a split limit");
+    return Split<static_vector<std::string_view, SplitsT + 1>>(str, delim, SplitsT);
+}
+
+template <size_t CountT>
+consteval std::array<std::string_view, CountT> Lud::SplitArray(const std::string_view str, char delim)
+{
+    return SplitArray<CountT>(str, std::string_view(&delim, 1));
+}
+
+template <size_t CountT>
+consteval std::array<std::string_view, CountT> Lud::SplitArray(const std::string_view str, const std::string_view delim)
+{
+    // one extra slot so that too many tokens is not reported as capacity exceeded
+    const auto tokens = Split<static_vector<std::string_view, CountT + 1>>(str, delim, CountT);
+    if (tokens.size() != CountT)
+    {
+        throw std::invalid_argument("wrong amount of tokens");
+    }
+    std::array<std::string_view, CountT> res;
+    std::ranges::copy(tokens, res.begin());
+    return res;
+}
+
+template <Lud::integer_type N, size_t CountT, int BaseT>
+consteval std::array<N, CountT> Lud::ParseArray(const std::string_view str, char delim)
+{
+    return ParseArray<N, CountT, BaseT>(str, std::string_view(&delim, 1));
+}
+
+template <Lud::integer_type N, size_t CountT, int BaseT>
+consteval std::array<N, CountT> Lud::ParseArray(const std::string_view str, const std::string_view delim)
+{
+    const auto tokens = SplitArray<CountT>(str, delim);
+    std::array<N, CountT> res{};
+    for (size_t i = 0; i < CountT; i++)
+    {
+        const auto num = is_num<N, BaseT>(tokens[i]);
+        if (!num)
+        {
+            throw std::invalid_argument("token is not a number");
+        }
+        res[i] = *num;
+    }
+    return res;
+}
+
+template <Lud::split_delim_type DelimT>
+constexpr Lud::split_view<DelimT>::split_view(std::string_view str, DelimT delim, size_t n)
+    : m_str(str)
+    , m_delim(delim)
+    , m_n(n)
+{
+}
+
+template <Lud::split_delim_type DelimT>
+constexpr Lud::split_view<DelimT>::iterator::iterator(std::string_view str, DelimT delim, size_t n)
+    : m_rest(str)
+    , m_delim(delim)
+    , m_n(n)
+    , m_done(false)
+{
+    if constexpr (std::same_as<DelimT, std::string_view>)
+    {
+        // same as Split, an empty delimiter yields the whole string once
+        if (m_delim.empty())
+        {
+            m_current = m_rest;
+            m_rest = {};
+            return;
+        }
+    }
+    next();
+}
+
+template <Lud::split_delim_type DelimT>
+constexpr void Lud::split_view<DelimT>::iterator::next()
+{
+    size_t delim_size = 1;
+    if constexpr (std::same_as<DelimT, std::string_view>)
+    {
+        delim_size = m_delim.size();
+    }
+
+    while (!m_rest.empty() && (m_n == 0 || m_count != m_n))
+    {
+        const size_t pos = m_rest.find(m_delim);
+        if (pos == std::string_view::npos)
+        {
+            break;
+        }
+        const std::string_view token = m_rest.substr(0, pos);
+        m_rest.remove_prefix(pos + delim_size);
+        // skips empty
+        if (!token.empty())
+        {
+            m_current = token;
+            m_count++;
+            return;
+        }
+    }
+    if (!m_rest.empty())
+    {
+        m_current = m_rest;
+        m_rest = {};
+        return;
+    }
+    m_current = {};
+    m_done = true;
+}
+
+template <Lud::split_delim_type DelimT>
+constexpr Lud::split_view<DelimT>::iterator& Lud::split_view<DelimT>::iterator::operator++()
+{
+    next();
+    return *this;
+}
+
+template <Lud::split_delim_type DelimT>
+constexpr Lud::split_view<DelimT>::iterator Lud::split_view<DelimT>::iterator::operator++(int)
+{
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+}
+
+template <Lud::split_delim_type DelimT>
+constexpr bool Lud::split_view<DelimT>::iterator::operator==(const iterator& other) const
+{
+    if (m_done || other.m_done)
+    {
+        return m_done == other.m_done;
+    }
+    return m_current.data() == other.m_current.data() && m_current.size() == other.m_current.size();
+}
+
+constexpr Lud::views::split_sv_closure<char> Lud::views::split_sv(char delim, size_t n)
+{
+    return {delim, n};
+}
+
+constexpr Lud::views::split_sv_closure<std::string_view> Lud::views::split_sv(std::string_view delim, size_t n)
+{
+    return {delim, n};
+}
+
+template <Lud::number_type N>
+Lud::parse_numbers_result Lud::ParseNumbers(const std::string_view str, char delim, std::vector<N>& out)
+{
+    parse_numbers_result res;
+    size_t token_begin = 0;
+    const auto parse_token = [&](size_t token_end) {
+        // skips empty
+        if (token_end == token_begin)
+        {
+            return true;
+        }
+        N val;
+        if (!detail::parse_number(str.substr(token_begin, token_end - token_begin), val))
+        {
+            res.error_token = res.count;
+            res.error_offset = token_begin;
+            return false;
+        }
+        out.push_back(val);
+        res.count++;
+        return true;
+    };
+
+    bool ok = true;
+    detail::scan_char(str, delim, [&](size_t pos) {
+        ok = parse_token(pos);
+        token_begin = pos + 1;
+        return ok;
+    });
+    if (ok)
+    {
+        parse_token(str.size());
+    }
+    return res;
+}
+
+template <Lud::number_type N>
+Lud::parse_numbers_result Lud::ParseNumbers(const std::string_view str, const std::string_view delim, std::vector<N>& out)
+{
+    parse_numbers_result res;
+    for (const auto token : split_view(str, delim))
+    {
+        N val;
+        if (!detail::parse_number(token, val))
+        {
+            res.error_token = res.count;
+            res.error_offset = static_cast<size_t>(token.data() - str.data());
+            break;
+        }
+        out.push_back(val);
+        res.count++;
+    }
+    return res;
+}
+
+template <Lud::range_of_string_view R>
+R Lud::ParallelSplit(const std::string_view str, char delim, const parallel_options& options)
+{
+    return detail::parallel_split<R>(str, delim, options);
+}
+
+template <Lud::range_of_string_view R>
+R Lud::ParallelSplit(const std::string_view str, const std::string_view delim, const parallel_options& options)
+{
+    return detail::parallel_split<R>(str, delim, options);
+}
+
+template <Lud::number_type N>
+Lud::parse_numbers_result Lud::ParallelParseNumbers(const std::string_view str, char delim, std::vector<N>& out, const parallel_options& options)
+{
+    return detail::parallel_parse_numbers(str, delim, out, options);
+}
+
+template <Lud::number_type N>
+Lud::parse_numbers_result Lud::ParallelParseNumbers(const std::string_view str, const std::string_view delim, std::vector<N>& out, const parallel_options& options)
+{
+    return detail::parallel_parse_numbers(str, delim, out, options);
+}
+
+inline Lud::csv_reader::csv_reader(const std::string_view data, char delim, char quote)
+    : m_data(data)
+    , m_delim(delim)
+    , m_quote(quote)
+{
+}
+
+template <typename T>
+    requires(sizeof(T) == 1)
+Lud::csv_reader::csv_reader(std::span<const T> data, char delim, char quote)
+    : csv_reader(std::string_view(reinterpret_cast<const char*>(data.data()), data.size()), delim, quote)
+{
+}
+
+inline bool Lud::csv_reader::next()
+{
+    m_fields.clear();
+    m_unescaped.clear();
+    m_escaped.clear();
+    if (m_pos >= m_data.size())
+    {
+        return false;
+    }
+    m_record_offset = m_pos;
+
+    const char* data = m_data.data();
+    const size_t size = m_data.size();
+    size_t pos = m_pos;
+    while (true)
+    {
+        if (pos < size && data[pos] == m_quote)
+        {
+            pos = read_quoted(pos + 1);
+            if (pos < size && data[pos] != m_delim && data[pos] != '\n' && data[pos] != '\r')
+            {
+                throw_malformed("unexpected character after closing quote", pos);
+            }
+        }
+        else
+        {
+            const size_t end = detail::find_csv_special(m_data, pos, m_delim);
+            m_fields.emplace_back(data + pos, end - pos);
+            pos = end;
+        }
+
+        if (pos < size && data[pos] == m_delim)
+        {
+            pos++;
+            continue;
+        }
+        break;
+    }
+    if (pos < size && data[pos] == '\r')
+    {
+        pos++;
+    }
+    if (pos < size && data[pos] == '\n')
+    {
+        pos++;
+    }
+    m_pos = pos;
+
+    // m_unescaped may have grown while reading the record, so the views are only made now
+    for (const auto& [idx, offset] : m_escaped)
+    {
+        m_fields[idx] = std::string_view(m_unescaped.data() + offset, m_fields[idx].size());
+    }
+    return true;
+}
+
+inline size_t Lud::csv_reader::read_quoted(size_t pos)
+{
+    const char* data = m_data.data();
+    const size_t start = pos;
+    const auto find_quote = [&](size_t from) {
+        size_t found = m_data.size();
+        detail::scan_char(m_data.substr(from), m_quote, [&](size_t i) {
+            found = from + i;
+            return false;
+        });
+        if (found == m_data.size())
+        {
+            // reported at the opening quote, whatever doubled quotes came after it
+            throw_malformed("unterminated quoted field", start - 1);
+        }
+        return found;
+    };
+
+    size_t close = find_quote(pos);
+    if (close + 1 >= m_data.size() || data[close + 1] != m_quote)
+    {
+        m_fields.emplace_back(data + start, close - start);
+        return close + 1;
+    }
+
+    // doubled quotes, the field is unescaped into m_unescaped
+    const size_t offset = m_unescaped.size();
+    while (close + 1 < m_data.size() && data[close + 1] == m_quote)
+    {
+        m_unescaped.append(data + pos, close + 1 - pos);
+        pos = close + 2;
+        close = find_quote(pos);
+    }
+    m_unescaped.append(data + pos, close - pos);
+
+    m_escaped.emplace_back(m_fields.size(), offset);
+    // only the size is meaningful until next() points it into m_unescaped
+    m_fields.emplace_back(data + start, m_unescaped.size() - offset);
+    return close + 1;
+}
+
+inline void Lud::csv_reader::throw_malformed(const char* what, size_t pos) const
+{
+    throw std::invalid_argument(std::string("csv_reader: ") + what + " at offset " + std::to_string(pos));
+}
+
+inline Lud::line_index::line_index(const std::string_view buffer)
+{
+    update(buffer);
+}
+
+template <typename F>
+decltype(auto) Lud::line_index::visit_offsets(F&& f) const
+{
+    if (m_wide)
+    {
+        return f(m_offsets64);
+    }
+    return f(m_offsets32);
+}
+
+inline void Lud::line_index::update(const std::string_view buffer)
+{
+    if (buffer.size() < m_buffer.size())
+    {
+        throw std::invalid_argument("line_index: buffer is shorter than the indexed data");
+    }
+    const size_t from = m_buffer.size();
+    if (!m_wide && buffer.size() > std::numeric_limits<uint32_t>::max())
+    {
+        m_offsets64.assign(m_offsets32.begin(), m_offsets32.end());
+        m_offsets32 = std::vector<uint32_t>();
+        m_wide = true;
+    }
+    m_buffer = buffer;
+
+    const auto scan = [&]<typename OffsetT>(std::vector<OffsetT>& offsets) {
+        detail::scan_char(buffer.substr(from), '\n', [&](size_t i) {
+            offsets.push_back(static_cast<OffsetT>(from + i + 1));
+            return true;
+        });
+    };
+    if (m_wide)
+    {
+        scan(m_offsets64);
+    }
+    else
+    {
+        scan(m_offsets32);
+    }
+}
+
+inline size_t Lud::line_index::size() const
+{
+    return visit_offsets([&](const auto& offsets) -> size_t {
+        // the offset after a trailing line break is where the next line will start
+        return offsets.size() - (offsets.back() == m_buffer.size());
+    });
+}
+
+inline std::string_view Lud::line_index::line(size_t idx) const
+{
+    return visit_offsets([&](const auto& offsets) {
+        const size_t begin = offsets[idx];
+        size_t end = idx + 1 < offsets.size() ? offsets[idx + 1] - 1 : m_buffer.size();
+        if (end > begin && m_buffer[end - 1] == '\r')
+        {
+            end--;
+        }
+        return m_buffer.substr(begin, end - begin);
+    });
+}
+
+inline size_t Lud::line_index::offset(size_t idx) const
+{
+    return visit_offsets([&](const auto& offsets) -> size_t {
+        return offsets[idx];
+    });
+}
+
+inline size_t Lud::line_index::line_of(size_t offset) const
+{
+    const size_t lines = size();
+    if (lines == 0)
+    {
+        return 0;
+    }
+    const size_t idx = visit_offsets([&](const auto& offsets) -> size_t {
+        return std::ranges::upper_bound(offsets, offset) - offsets.begin() - 1;
+    });
+    return std::min(idx, lines - 1);
+}
+
+inline std::string Lud::ToUpper(const std::string_view str)
+{
+    std::string res;
+    ToUpper(res, str);
+    return res;
+}
+
+inline std::string Lud::ToLower(const std::string_view str)
+{
+    std::string res;
+    ToLower(res, str);
+    return res;
+}
+
+inline std::string Lud::ToTitle(const std::string_view str)
+{
+    std::string res;
+    ToTitle(res, str);
+    return res;
+}
+
+inline std::string Lud::Capitalize(const std::string_view str)
+{
+    std::string res;
+    Capitalize(res, str);
+    return res;
+}
+
+inline std::string& Lud::ToUpper(std::string& out, const std::string_view str)
+{
+    if (detail::overlaps(out, str))
+    {
+        return ToUpper(out, std::string(str));
+    }
+    return detail::append_overwrite(out, str.size(), [&](char* buf) {
+        std::char_traits<char>::copy(buf, str.data(), str.size());
+        detail::convert_case<true>(buf, str.size());
+    });
+}
+
+inline std::span<char> Lud::ToUpper(std::span<char> out, const std::string_view str)
+{
+    return detail::span_overwrite(out, str.size(), [&](char* buf) {
+        std::char_traits<char>::copy(buf, str.data(), str.size());
+        detail::convert_case<true>(buf, str.size());
+    });
+}
+
+template <std::output_iterator<char> OutT>
+OutT Lud::ToUpper(OutT out, const std::string_view str)
+{
+    return detail::transform_chunks(out, str, [](char* buf, size_t size) {
+        detail::convert_case<true>(buf, size);
+    });
+}
+
+inline std::string& Lud::ToLower(std::string& out, const std::string_view str)
+{
+    if (detail::overlaps(out, str))
     {
-        return std::nullopt;
+        return ToLower(out, std::string(str));
     }
-    return val;
+    return detail::append_overwrite(out, str.size(), [&](char* buf) {
+        std::char_traits<char>::copy(buf, str.data(), str.size());
+        detail::convert_case<false>(buf, str.size());
+    });
 }
 
-template <Lud::real_type N>
-std::optional<N> Lud::is_num(const std::string_view sv, const std::chars_format fmt /*=std::chars_format::general)*/)
+inline std::span<char> Lud::ToLower(std::span<char> out, const std::string_view str)
 {
-    auto check = Strip(sv);
-    // if (std::to_underlying(fmt) & std::to_underlying(std::chars_format::hex))
-    // {
-    //     inplace::RemovePrefix(check, "0X");
-    // }
-    // else
-    // {
-    //     inplace::RemovePrefix(check, "+");
-    // }
+    return detail::span_overwrite(out, str.size(), [&](char* buf) {
+        std::char_traits<char>::copy(buf, str.data(), str.size());
+        detail::convert_case<false>(buf, str.size());
+    });
+}
 
-    N val{};
-    const auto first = check.data();
-    const auto last = first + check.size();
-    const auto res = std::from_chars(first, last, val, fmt);
-    if (res.ec == std::errc::invalid_argument || res.ec == std::errc::result_out_of_range)
+template <std::output_iterator<char> OutT>
+OutT Lud::ToLower(OutT out, const std::string_view str)
+{
+    return detail::transform_chunks(out, str, [](char* buf, size_t size) {
+        detail::convert_case<false>(buf, size);
+    });
+}
+
+inline std::string& Lud::ToTitle(std::string& out, const std::string_view str)
+{
+    if (detail::overlaps(out, str))
     {
-        return std::nullopt;
+        return ToTitle(out, std::string(str));
     }
-    if (res.ptr != last)
+    return detail::append_overwrite(out, str.size(), [&](char* buf) {
+        detail::copy_title(buf, str);
+    });
+}
+
+inline std::span<char> Lud::ToTitle(std::span<char> out, const std::string_view str)
+{
+    return detail::span_overwrite(out, str.size(), [&](char* buf) {
+        detail::copy_title(buf, str);
+    });
+}
+
+template <std::output_iterator<char> OutT>
+OutT Lud::ToTitle(OutT out, const std::string_view str)
+{
+    // word starts depend on the previous char, so this one does not go through chunks
+    bool prev_ws = true;
+    for (const char c : str)
     {
-        return std::nullopt;
+        const bool ws = detail::is_whitespace(c);
+        *out++ = !ws && prev_ws ? detail::convert_case<true>(c) : c;
+        prev_ws = ws;
     }
-    return val;
+    return out;
 }
 
-template <Lud::real_type N>
-std::optional<N> Lud::is_fraction(const std::string_view sv)
+inline std::string& Lud::Capitalize(std::string& out, const std::string_view str)
 {
-    if (!sv.contains("/"))
+    if (detail::overlaps(out, str))
     {
-        return std::nullopt;
+        return Capitalize(out, std::string(str));
     }
-    auto parts = Lud::Split(sv, "/");
-    if (parts.size() != 2)
+    return detail::append_overwrite(out, str.size(), [&](char* buf) {
+        detail::copy_capitalized(buf, str);
+    });
+}
+
+inline std::span<char> Lud::Capitalize(std::span<char> out, const std::string_view str)
+{
+    return detail::span_overwrite(out, str.size(), [&](char* buf) {
+        detail::copy_capitalized(buf, str);
+    });
+}
+
+template <std::output_iterator<char> OutT>
+OutT Lud::Capitalize(OutT out, const std::string_view str)
+{
+    if (str.empty())
     {
-        return std::nullopt;
+        return out;
     }
+    *out++ = detail::convert_case<true>(str[0]);
+    return std::ranges::copy(str.substr(1), out).out;
+}
 
-    auto numerator = Lud::is_num<N>(parts[0]);
-    auto denominator = Lud::is_num<N>(parts[1]);
+constexpr std::string_view Lud::LStrip(const std::string_view str)
+{
+    const auto idx = detail::first_not_whitespace(str);
 
-    if (!(numerator && denominator))
+    if (idx == std::string_view::npos)
     {
-        return std::nullopt;
+        return {};
     }
-    if (denominator.value() == 0)
+
+    return str.substr(idx);
+}
+
+constexpr std::string_view Lud::RStrip(const std::string_view str)
+{
+    const auto idx = detail::last_not_whitespace(str);
+
+    if (idx == std::string_view::npos)
     {
-        return std::numeric_limits<N>::quiet_NaN();
+        return {};
     }
-    return numerator.value() / denominator.value();
+
+    return str.substr(0, idx + 1);
 }
 
-template <Lud::real_type N>
-std::optional<N> Lud::is_percentage(const std::string_view sv)
+constexpr std::string_view Lud::Strip(const std::string_view str)
 {
-    auto check = Lud::Strip(sv);
-    const auto first = check.find_first_of('%');
-    if (!(first != std::string::npos && first == check.find_last_of('%')))
+    const size_t begin = detail::first_not_whitespace(str);
+    if (begin == std::string_view::npos)
     {
-        return std::nullopt;
+        return {};
     }
+    const size_t end = detail::last_not_whitespace(str);
+
+    return str.substr(begin, end - begin + 1);
+}
+
+inline std::string Lud::Reverse(const std::string_view str)
+{
+    std::string res;
+    Reverse(res, str);
+    return res;
+}
 
-    auto num = Lud::is_num<N>(Lud::RemoveSuffix(check, "%"));
-    if (!num)
+inline std::string& Lud::Reverse(std::string& out, const std::string_view str)
+{
+    if (detail::overlaps(out, str))
     {
-        return std::nullopt;
+        return Reverse(out, std::string(str));
     }
+    return detail::append_overwrite(out, str.size(), [&](char* buf) {
+        std::ranges::reverse_copy(str, buf);
+    });
+}
 
-    return num.value() / 100.0f;
+inline std::span<char> Lud::Reverse(std::span<char> out, const std::string_view str)
+{
+    return detail::span_overwrite(out, str.size(), [&](char* buf) {
+        std::ranges::reverse_copy(str, buf);
+    });
 }
 
-template <Lud::string_container Container>
-std::string Lud::Join(const Container& container, const std::string_view delim)
+template <std::output_iterator<char> OutT>
+OutT Lud::Reverse(OutT out, const std::string_view str)
 {
-    return Join(container.begin(), container.end(), delim);
+    return std::ranges::reverse_copy(str, out).out;
 }
 
-template <Lud::string_container Container>
-std::string Lud::Join(const Container& container, char delim)
+inline std::string Lud::Replace(const std::string_view str, const std::string_view pattern, const std::string_view replacement)
 {
-    return Join(container.begin(), container.end(), delim);
+    std::string res;
+    Replace(res, str, pattern, replacement);
+    return res;
 }
 
-template <std::input_iterator T>
-std::string Lud::Join(T first, T last, const std::string_view delim)
+inline std::string Lud::Replace(const std::string_view str, char pattern, char replacement)
 {
     std::string res;
-    if (first >= last)
+    Replace(res, str, pattern, replacement);
+    return res;
+}
+
+inline std::string& Lud::Replace(std::string& out, const std::string_view str, const std::string_view pattern, const std::string_view replacement)
+{
+    if (detail::overlaps(out, str) || detail::overlaps(out, pattern) || detail::overlaps(out, replacement))
     {
-        return res;
+        return Replace(out, std::string(str), std::string(pattern), std::string(replacement));
     }
-    res.append(static_cast<std::string>(*first));
-    for (auto it = first + 1; it != last; ++it)
+    if (pattern.empty())
     {
-        res.append(delim);
-        res.append(static_cast<std::string>(*it));
+        return out.append(str);
     }
+    return detail::append_overwrite(out, detail::replaced_size(str, pattern, replacement), [&](char* buf) {
+        detail::replace_copy(buf, str, pattern, replacement);
+    });
+}
 
-    return res;
+inline std::span<char> Lud::Replace(std::span<char> out, const std::string_view str, const std::string_view pattern, const std::string_view replacement)
+{
+    if (pattern.empty())
+    {
+        return detail::span_overwrite(out, str.size(), [&](char* buf) {
+            std::char_traits<char>::copy(buf, str.data(), str.size());
+        });
+    }
+    return detail::span_overwrite(out, detail::replaced_size(str, pattern, replacement), [&](char* buf) {
+        detail::replace_copy(buf, str, pattern, replacement);
+    });
 }
 
-template <std::input_iterator T>
-std::string Lud::Join(T first, T last, char delim)
+template <std::output_iterator<char> OutT>
+OutT Lud::Replace(OutT out, const std::string_view str, const std::string_view pattern, const std::string_view replacement)
 {
-    std::string res;
-    if (first >= last)
+    if (pattern.empty())
     {
-        return res;
+        return std::ranges::copy(str, out).out;
     }
-    res.append(static_cast<std::string>(*first));
-    for (auto it = first + 1; it != last; ++it)
+    size_t read = 0;
+    for (size_t pos = str.find(pattern); pos != std::string_view::npos; pos = str.find(pattern, read))
     {
-        res += delim;
-        res.append(static_cast<std::string>(*it));
+        out = std::ranges::copy(str.substr(read, pos - read), out).out;
+        out = std::ranges::copy(replacement, out).out;
+        read = pos + pattern.size();
     }
-
-    return res;
+    return std::ranges::copy(str.substr(read), out).out;
 }
 
-inline std::string_view Lud::RemovePrefix(const std::string_view str, const std::string_view prefix)
+inline std::string& Lud::Replace(std::string& out, const std::string_view str, char pattern, char replacement)
 {
-
-    if (str.starts_with(prefix))
+    if (detail::overlaps(out, str))
     {
-        return str.substr(prefix.size());
+        return Replace(out, std::string(str), pattern, replacement);
     }
-
-    return str;
+    return detail::append_overwrite(out, str.size(), [&](char* buf) {
+        std::ranges::replace_copy(str, buf, pattern, replacement);
+    });
 }
 
-inline std::string_view Lud::RemoveSuffix(const std::string_view str, const std::string_view suffix)
+inline std::span<char> Lud::Replace(std::span<char> out, const std::string_view str, char pattern, char replacement)
 {
-    if (str.ends_with(suffix))
-    {
-        return str.substr(0, str.size() - suffix.size());
-    }
+    return detail::span_overwrite(out, str.size(), [&](char* buf) {
+        std::ranges::replace_copy(str, buf, pattern, replacement);
+    });
+}
 
-    return str;
+template <std::output_iterator<char> OutT>
+OutT Lud::Replace(OutT out, const std::string_view str, char pattern, char replacement)
+{
+    return std::ranges::replace_copy(str, out, pattern, replacement).out;
 }
 
-inline std::string& Lud::inplace::RemovePrefix(std::string& str, const std::string_view prefix)
+inline Lud::replace_set::replace_set(std::initializer_list<pair_type> pairs)
 {
-    if (str.starts_with(prefix))
+    for (const auto& [pattern, replacement] : pairs)
     {
-        str.erase(0, prefix.size());
+        add(pattern, replacement);
     }
-    return str;
+    build();
 }
 
-inline std::string& Lud::inplace::RemoveSuffix(std::string& str, const std::string_view suffix)
+template <std::ranges::input_range RangeT>
+    requires std::convertible_to<std::ranges::range_value_t<RangeT>, Lud::replace_set::pair_type>
+Lud::replace_set::replace_set(const RangeT& pairs)
 {
-    if (str.ends_with(suffix))
+    for (const auto& pair : pairs)
     {
-        str.erase(str.size() - suffix.size());
+        const pair_type p = pair;
+        add(p.first, p.second);
     }
-    return str;
+    build();
 }
 
-template <Lud::range_of_string_view R>
-R Lud::Split(const std::string_view str, const std::string_view delim, size_t n)
+inline void Lud::replace_set::add(std::string_view pattern, std::string_view replacement)
 {
-    R r;
-    if (delim.empty())
+    // empty patterns would match everywhere, duplicates would never be reached
+    if (pattern.empty() || std::ranges::find(m_patterns, pattern) != m_patterns.end())
     {
-        std::inserter(r, r.end()) = str;
-        return r;
+        return;
     }
-    size_t next = str.find(delim);
-    std::string_view inner_str = str;
-    while (next != std::string_view::npos && (n != std::ranges::size(r) || n == 0))
+    m_patterns.emplace_back(pattern);
+    m_replacements.emplace_back(replacement);
+}
+
+inline void Lud::replace_set::build()
+{
+    // class 0 is every byte not present in any pattern
+    for (const auto& pattern : m_patterns)
     {
-        // skips empty
-        if (next != 0)
+        for (const char c : pattern)
         {
-            std::inserter(r, r.end()) = inner_str.substr(0, next);
+            auto& cls = m_classes[static_cast<unsigned char>(c)];
+            if (cls == 0)
+            {
+                cls = static_cast<uint16_t>(m_class_count++);
+            }
         }
-        inner_str.remove_prefix(next + delim.size());
-        next = inner_str.find(delim);
     }
-    if (!inner_str.empty())
+
+    // trie, 0 is both the root and "no transition" since nothing goes back to the root while building
+    m_transitions.assign(m_class_count, 0);
+    m_match.assign(1, no_match);
+    m_depth.assign(1, 0);
+    for (size_t idx = 0; idx < m_patterns.size(); idx++)
     {
-        std::inserter(r, r.end()) = inner_str;
+        uint32_t state = 0;
+        for (const char c : m_patterns[idx])
+        {
+            const size_t t = state * m_class_count + m_classes[static_cast<unsigned char>(c)];
+            if (m_transitions[t] == 0)
+            {
+                m_transitions[t] = static_cast<uint32_t>(m_match.size());
+                m_transitions.resize(m_transitions.size() + m_class_count, 0);
+                m_match.push_back(no_match);
+                m_depth.push_back(m_depth[state] + 1);
+            }
+            state = m_transitions[t];
+        }
+        m_match[state] = static_cast<int32_t>(idx);
     }
 
-    return r;
-}
-template <Lud::range_of_string_view R>
-R Lud::Split(const std::string_view str, char delim, size_t n)
-{
-    R r;
-    size_t next = str.find(delim);
-    std::string_view inner_str = str;
-    while (next != std::string_view::npos && (n != std::ranges::size(r) || n == 0))
+    // breadth first so fail links always point to finished states, missing transitions
+    // get filled with the ones of the fail state turning the trie into a DFA
+    std::vector<uint32_t> fail(m_match.size(), 0);
+    std::vector<uint32_t> queue;
+    queue.reserve(m_match.size());
+    for (size_t cls = 0; cls < m_class_count; cls++)
     {
-        // skips empty
-        if (next != 0)
+        if (const uint32_t child = m_transitions[cls]; child != 0)
         {
-            std::inserter(r, r.end()) = inner_str.substr(0, next);
+            queue.push_back(child);
         }
-        inner_str.remove_prefix(next + 1);
-        next = inner_str.find(delim);
     }
-    if (!inner_str.empty())
+    for (size_t head = 0; head < queue.size(); head++)
     {
-        std::inserter(r, r.end()) = inner_str;
+        const uint32_t state = queue[head];
+        if (m_match[state] == no_match)
+        {
+            m_match[state] = m_match[fail[state]];
+        }
+        for (size_t cls = 0; cls < m_class_count; cls++)
+        {
+            uint32_t& child = m_transitions[state * m_class_count + cls];
+            const uint32_t fallback = m_transitions[fail[state] * m_class_count + cls];
+            if (child == 0)
+            {
+                child = fallback;
+            }
+            else
+            {
+                fail[child] = fallback;
+                queue.push_back(child);
+            }
+        }
     }
-
-    return r;
 }
 
-inline std::string Lud::ToUpper(const std::string_view str)
+template <typename F>
+void Lud::replace_set::for_each_match(const std::string_view str, F&& f) const
 {
-    std::string res(str);
-
-    inplace::ToUpper(res);
-
-    return res;
+    if (m_patterns.empty())
+    {
+        return;
+    }
+    // a candidate is only final once no match can start at or before it, that is when
+    // the current state, the longest prefix of a pattern we are in, starts after it
+    size_t pos = 0;
+    while (pos < str.size())
+    {
+        uint32_t state = 0;
+        size_t best_start = std::string_view::npos;
+        int32_t best = no_match;
+        size_t i = pos;
+        for (; i < str.size(); i++)
+        {
+            state = next_state(state, str[i]);
+            const int32_t match = m_match[state];
+            if (match != no_match)
+            {
+                const size_t start = i + 1 - m_patterns[match].size();
+                if (best == no_match || start < best_start || (start == best_start && m_patterns[match].size() > m_patterns[best].size()))
+                {
+                    best = match;
+                    best_start = start;
+                }
+            }
+            if (best != no_match && i + 1 - m_depth[state] > best_start)
+            {
+                break;
+            }
+        }
+        if (best == no_match)
+        {
+            return;
+        }
+        f(best_start, static_cast<size_t>(best));
+        pos = best_start + m_patterns[best].size();
+    }
 }
 
-inline std::string Lud::ToLower(const std::string_view str)
+inline std::string Lud::ReplaceAll(const std::string_view str, const replace_set& set)
 {
-    std::string res(str);
-
-    inplace::ToLower(res);
-
+    std::string res;
+    res.reserve(str.size());
+    size_t read = 0;
+    set.for_each_match(str, [&](size_t pos, size_t idx) {
+        res.append(str.substr(read, pos - read));
+        res.append(set.replacement(idx));
+        read = pos + set.pattern_size(idx);
+    });
+    res.append(str.substr(read));
     return res;
 }
 
-inline std::string Lud::ToTitle(const std::string_view str)
+inline std::string Lud::ReplaceAll(const std::string_view str, std::initializer_list<replace_set::pair_type> pairs)
 {
-    std::string res(str);
-
-    inplace::ToTitle(res);
-
-    return res;
+    return ReplaceAll(str, replace_set(pairs));
 }
 
-inline std::string Lud::Capitalize(const std::string_view str)
+inline std::string& Lud::inplace::ReplaceAll(std::string& str, const replace_set& set)
 {
-    std::string res(str);
-
-    inplace::Capitalize(res);
-
-    return res;
+    str = Lud::ReplaceAll(str, set);
+    return str;
 }
 
-inline std::string_view Lud::LStrip(const std::string_view str)
+constexpr Lud::char_set::char_set(const std::string_view chars)
 {
-    const auto delims = "\t\n\r ";
-    const auto idx = str.find_first_not_of(delims);
-
-    if (idx == std::string_view::npos)
+    for (const char c : chars)
     {
-        return {};
+        insert(c);
     }
-
-    return str.substr(idx);
 }
 
-inline std::string_view Lud::RStrip(const std::string_view str)
+constexpr void Lud::char_set::insert(char c)
 {
-    const auto delims = "\t\n\r ";
-    const auto idx = str.find_last_not_of(delims);
+    const auto uc = static_cast<unsigned char>(c);
+    m_bits[uc >> 6] |= uint64_t{1} << (uc & 63);
+    m_rows[uc >> 7][uc & 0x0F] |= static_cast<uint8_t>(1 << ((uc >> 4) & 7));
+}
 
-    if (idx == std::string_view::npos)
-    {
-        return {};
-    }
+constexpr void Lud::char_set::erase(char c)
+{
+    const auto uc = static_cast<unsigned char>(c);
+    m_bits[uc >> 6] &= ~(uint64_t{1} << (uc & 63));
+    m_rows[uc >> 7][uc & 0x0F] &= static_cast<uint8_t>(~(1 << ((uc >> 4) & 7)));
+}
 
-    return str.substr(0, idx + 1);
+constexpr bool Lud::char_set::contains(char c) const
+{
+    const auto uc = static_cast<unsigned char>(c);
+    return (m_bits[uc >> 6] >> (uc & 63)) & 1;
 }
 
-inline std::string_view Lud::Strip(const std::string_view str)
+constexpr size_t Lud::char_set::size() const
 {
-    constexpr auto delims = "\t\n\r ";
-    const size_t begin = str.find_first_not_of(delims);
-    const size_t end = str.find_last_not_of(delims);
-    if (begin == std::string_view::npos)
+    size_t count = 0;
+    for (const auto word : m_bits)
     {
-        return {};
+        count += std::popcount(word);
     }
-
-    return str.substr(begin, end - begin + 1);
+    return count;
 }
 
-inline std::string Lud::Reverse(const std::string_view str)
+inline bool Lud::ContainsAny(const std::string_view str, const std::string_view pattern)
 {
-    return {str.rbegin(), str.rend()};
+    return ContainsAny(str, char_set(pattern));
 }
 
-inline std::string Lud::Replace(const std::string_view str, const std::string_view pattern, const std::string_view replacement)
+inline size_t Lud::char_set::find_first(const std::string_view str) const
 {
-    std::string res{str};
-    return inplace::Replace(res, pattern, replacement);
+    static const auto kernel = dispatch_table<detail::find_in_set_fn>{
+        .scalar = detail::find_in_set_scalar,
+#if defined(LUD_SIMD_DISPATCH)
+        .ssse3 = detail::find_in_set_ssse3,
+        .avx2 = detail::find_in_set_avx2,
+#endif
+    }.select();
+    return find_first(str, kernel);
 }
 
-inline std::string Lud::Replace(const std::string_view str, char pattern, char replacement)
+inline size_t Lud::char_set::find_first(const std::string_view str, detail::find_in_set_fn kernel) const
 {
-    std::string res{str};
-    return inplace::Replace(res, pattern, replacement);
+    static_assert(sizeof(m_rows) == 32, "the kernels read both rows as one 32 byte table");
+    return kernel(m_rows[0].data(), m_bits.data(), str.data(), str.size());
 }
 
-inline bool Lud::ContainsAny(const std::string_view str, const std::string_view pattern)
+inline bool Lud::ContainsAny(const std::string_view str, const char_set& set)
 {
-    for (const auto& c : str)
-    {
-        if (pattern.contains(c))
-        {
-            return true;
-        }
-    }
-    return false;
+    return !set.empty() && set.find_first(str) != std::string_view::npos;
 }
 
 inline bool Lud::ContainsAll(const std::string_view str, const std::string_view pattern)
 {
-    size_t counter = 0;
-    for (const auto& c : str)
+    return ContainsAll(str, char_set(pattern));
+}
+
+inline bool Lud::ContainsAll(const std::string_view str, const char_set& set)
+{
+    // chars are dropped once seen, so the scan only stops on the ones still missing
+    char_set missing = set;
+    size_t pos = 0;
+    while (!missing.empty())
     {
-        if (pattern.contains(c))
-        {
-            counter++;
-        }
-        if (counter >= pattern.size())
+        const size_t found = missing.find_first(str.substr(pos));
+        if (found == std::string_view::npos)
         {
-            return true;
+            return false;
         }
+        missing.erase(str[pos + found]);
+        pos += found + 1;
     }
-    return false;
+    return true;
 }
 
 inline bool Lud::IsBlank(const std::string_view str)
 {
-    const auto delims = "\t\n\r ";
-    const auto idx = str.find_last_not_of(delims);
-
-    return idx == std::string_view::npos;
+    return detail::first_not_whitespace(str) == std::string_view::npos;
 }
 
 inline std::string& Lud::inplace::ToUpper(std::string& str)
 {
-    std::ranges::transform(str, str.begin(), [](char c) {
-        return std::toupper(c);
-    });
+    detail::convert_case<true>(str.data(), str.size());
 
     return str;
 }
 
 inline std::string& Lud::inplace::ToLower(std::string& str)
 {
-    std::ranges::transform(str, str.begin(), [](char c) {
-        return std::tolower(c);
-    });
+    detail::convert_case<false>(str.data(), str.size());
     return str;
 }
 
@@ -569,31 +3777,22 @@ inline std::string& Lud::inplace::Capitalize(std::string& str)
 {
     if (!str.empty())
     {
-        str[0] = static_cast<char>(std::toupper(str[0]));
+        str[0] = detail::convert_case<true>(str[0]);
     }
     return str;
 }
 
 inline std::string& Lud::inplace::ToTitle(std::string& str)
 {
-    const auto delim = "\t\n\r ";
-    auto idx = str.find_first_not_of(delim);
-    while (idx != std::string::npos)
-    {
-        str[idx] = static_cast<char>(std::toupper(str[idx]));
-        idx = str.find_first_of(delim, idx + 1);
-        if (idx != std::string::npos)
-        {
-            idx = str.find_first_not_of(delim, idx + 1);
-        }
-    }
+    detail::scan_word_starts(str, [&](size_t idx) {
+        str[idx] = detail::convert_case<true>(str[idx]);
+    });
     return str;
 }
 
 inline std::string& Lud::inplace::LStrip(std::string& str)
 {
-    const auto delims = "\t\n\r ";
-    const auto idx = str.find_first_not_of(delims);
+    const auto idx = detail::first_not_whitespace(str);
 
     str.erase(0, idx);
     return str;
@@ -601,8 +3800,7 @@ inline std::string& Lud::inplace::LStrip(std::string& str)
 
 inline std::string& Lud::inplace::RStrip(std::string& str)
 {
-    const auto delims = "\t\n\r ";
-    const auto idx = str.find_last_not_of(delims);
+    const auto idx = detail::last_not_whitespace(str);
 
     str.erase(idx + 1);
 
@@ -611,9 +3809,8 @@ inline std::string& Lud::inplace::RStrip(std::string& str)
 
 inline std::string& Lud::inplace::Strip(std::string& str)
 {
-    const auto delims = "\t\n\r ";
-    const auto first = str.find_first_not_of(delims);
-    const auto last = str.find_last_not_of(delims);
+    const auto first = detail::first_not_whitespace(str);
+    const auto last = detail::last_not_whitespace(str);
 
     str.erase(last + 1);
     str.erase(0, first);
@@ -628,12 +3825,38 @@ inline std::string& Lud::inplace::Reverse(std::string& str)
 }
 inline std::string& Lud::inplace::Replace(std::string& str, const std::string_view pattern, const std::string_view replacement)
 {
+    using TraitsT = std::char_traits<char>;
+    if (pattern.empty())
+    {
+        return str;
+    }
+    // growing or reading from our own buffer, can't be done without a second buffer
+    if (replacement.size() > pattern.size() || detail::overlaps(str, pattern) || detail::overlaps(str, replacement))
+    {
+        str = Lud::Replace(str, pattern, replacement);
+        return str;
+    }
+
     size_t pos = str.find(pattern);
+    if (pos == std::string::npos)
+    {
+        return str;
+    }
+    // writes never get ahead of reads since the replacement is not longer than the pattern
+    char* data = str.data();
+    size_t write = pos;
+    size_t read = pos;
     while (pos != std::string::npos)
     {
-        str.replace(pos, pattern.size(), replacement);
-        pos = str.find(pattern);
+        TraitsT::move(data + write, data + read, pos - read);
+        write += pos - read;
+        TraitsT::copy(data + write, replacement.data(), replacement.size());
+        write += replacement.size();
+        read = pos + pattern.size();
+        pos = str.find(pattern, read);
     }
+    TraitsT::move(data + write, data + read, str.size() - read);
+    str.resize(write + str.size() - read);
 
     return str;
 }
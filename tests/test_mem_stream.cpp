@@ -0,0 +1,421 @@
+#include "catch2/catch_test_macros.hpp"
+#include "ludutils/lud_mapped_file.hpp"
+#include "ludutils/lud_mem_stream.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+// file in the temp directory, removed when it goes out of scope
+struct temp_file
+{
+    std::filesystem::path path;
+
+    temp_file(const std::string& name, const std::string& contents)
+        : path(std::filesystem::temp_directory_path() / name)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+    }
+
+    ~temp_file()
+    {
+        std::filesystem::remove(path);
+    }
+};
+
+} // namespace
+
+TEST_CASE("Mapped file", "[mem_stream][mmap]")
+{
+    std::string contents;
+    for (int i = 0; i < 10000; i++)
+    {
+        contents += "line " + std::to_string(i) + "\n";
+    }
+    const temp_file file("ludutils_mapped_file.txt", contents);
+
+    SECTION("Maps the whole file")
+    {
+        Lud::mapped_file mapped(file.path, Lud::access_hint::sequential);
+        REQUIRE(mapped.size() == contents.size());
+        REQUIRE(mapped.view() == contents);
+        mapped.advise(Lud::access_hint::random, 5000, 100);
+        mapped.advise(Lud::access_hint::willneed, mapped.size() + 1, 1);
+
+        Lud::mapped_file moved = std::move(mapped);
+        REQUIRE(mapped.empty());
+        REQUIRE(moved.view() == contents);
+        moved.close();
+        REQUIRE(moved.empty());
+    }
+
+    SECTION("Empty and missing files")
+    {
+        const temp_file empty("ludutils_mapped_file_empty.txt", "");
+        Lud::mapped_file mapped(empty.path);
+        REQUIRE(mapped.empty());
+        REQUIRE(mapped.bytes().empty());
+
+        REQUIRE_THROWS_AS(Lud::mapped_file(file.path.string() + ".missing"), std::system_error);
+    }
+
+    SECTION("Istream over the mapping")
+    {
+        Lud::mmap_istream stream(file.path);
+        std::string line;
+        int count = 0;
+        while (std::getline(stream, line))
+        {
+            REQUIRE(line == "line " + std::to_string(count));
+            count++;
+        }
+        REQUIRE(count == 10000);
+
+        stream.clear();
+        stream.seekg(5);
+        int first;
+        stream >> first;
+        REQUIRE(first == 0);
+    }
+}
+
+TEST_CASE("Memory istream positioning", "[mem_stream]")
+{
+    const std::string_view text = "0123456789";
+    Lud::memory_istream<char> stream(std::span(text.data(), text.size()));
+
+    REQUIRE(stream.rdbuf()->in_avail() == 10);
+    stream.seekg(-3, std::ios::end);
+    REQUIRE(stream.tellg() == 7);
+    REQUIRE(stream.peek() == '7');
+    stream.seekg(-2, std::ios::cur);
+    char buf[4]{};
+    stream.read(buf, 3);
+    REQUIRE(std::string_view(buf, 3) == "567");
+
+    // seeks out of the view fail and leave the position alone
+    stream.seekg(11);
+    REQUIRE(stream.fail());
+    stream.clear();
+    REQUIRE(stream.tellg() == 8);
+    stream.seekg(-9, std::ios::cur);
+    REQUIRE(stream.fail());
+    stream.clear();
+
+    stream.seekg(0, std::ios::end);
+    REQUIRE(stream.peek() == std::char_traits<char>::eof());
+    REQUIRE(stream.rdbuf()->in_avail() == -1);
+}
+
+TEST_CASE("Memory istream binary reads", "[mem_stream]")
+{
+    // a frame with a big endian header and a little endian payload
+    const std::vector<uint8_t> frame = {
+        0xCA, 0xFE, 0x00, 0x00, 0x00, 0x03,
+        0x01, 0x00, 0x02, 0x00, 0x03, 0x00,
+        0x00, 0x00, 0x80, 0x3F,
+        'a', 'b', 'c',
+    };
+    Lud::memory_istream stream{std::span<const uint8_t>(frame)};
+
+    REQUIRE(stream.read<uint16_t>(std::endian::big) == 0xCAFE);
+    enum class count_t : uint32_t;
+    REQUIRE(stream.read<count_t>(std::endian::big) == count_t{3});
+
+    std::array<uint16_t, 3> payload{};
+    REQUIRE(stream.read_into(std::span(payload), std::endian::little));
+    REQUIRE(payload == std::array<uint16_t, 3>{1, 2, 3});
+    REQUIRE(stream.read<float>(std::endian::little) == 1.0f);
+
+    // the view points into the frame itself
+    const auto tail = stream.read_view(3);
+    REQUIRE(tail.data() == frame.data() + 16);
+    REQUIRE(tail.size() == 3);
+    REQUIRE(stream.read_view(0).empty());
+    REQUIRE(stream.good());
+
+    SECTION("Short reads fail")
+    {
+        stream.seekg(-2, std::ios::end);
+        REQUIRE(stream.read<uint32_t>() == 0);
+        REQUIRE(stream.fail());
+        REQUIRE(stream.eof());
+        stream.clear();
+        // nothing was consumed by the failed read
+        REQUIRE(stream.tellg() == 17);
+
+        const auto rest = stream.read_view(10);
+        REQUIRE(rest.size() == 2);
+        REQUIRE(stream.fail());
+        REQUIRE(stream.read_view(1).empty());
+    }
+
+    SECTION("Base read is still there")
+    {
+        stream.seekg(16);
+        char text[3];
+        stream.read(text, 3);
+        REQUIRE(std::string_view(text, 3) == "abc");
+    }
+}
+
+TEST_CASE("Vector stream positioning", "[mem_stream]")
+{
+    std::vector<uint8_t> vec;
+    {
+        Lud::vector_ostream out(vec);
+        out << "hello";
+        out.seekp(-2, std::ios::end);
+        REQUIRE(out.tellp() == 3);
+        out.put('L');
+        REQUIRE_THROWS_AS(out.rdbuf()->pubseekoff(6, std::ios::beg, std::ios::out), std::range_error);
+    }
+    REQUIRE(std::string(vec.begin(), vec.end()) == "helLo");
+
+    Lud::vector_istream in(vec);
+    in.seekg(1);
+    REQUIRE(in.rdbuf()->in_avail() == 4);
+    std::string rest;
+    in >> rest;
+    REQUIRE(rest == "elLo");
+    REQUIRE_THROWS_AS(in.rdbuf()->pubseekoff(-6, std::ios::end, std::ios::in), std::range_error);
+}
+
+TEST_CASE("Vector stream growth and sync", "[mem_stream]")
+{
+    SECTION("Flushing publishes the size without reallocating")
+    {
+        std::vector<uint8_t> vec;
+        vec.reserve(1024);
+        const uint8_t* storage = vec.data();
+        Lud::vector_ostream out(vec);
+        for (int i = 0; i < 50; i++)
+        {
+            out << "line " << i << std::endl;
+            REQUIRE(vec.data() == storage);
+        }
+        out << "tail";
+        out.flush();
+        REQUIRE(std::string(vec.begin(), vec.end()).ends_with("line 49\ntail"));
+        // sync never gives the capacity back
+        REQUIRE(vec.capacity() == 1024);
+        out.shrink_to_fit();
+        REQUIRE(vec.capacity() == vec.size());
+        out << '!';
+        out.flush();
+        REQUIRE(vec.back() == '!');
+    }
+
+    SECTION("Growth policies")
+    {
+        const Lud::growth_policy by_factor{.factor = 2.0};
+        REQUIRE(by_factor.next_capacity(100, 101) == 200);
+        REQUIRE(by_factor.next_capacity(0, 1) == 1);
+        const Lud::growth_policy chunked{.chunk = 1000};
+        REQUIRE(chunked.next_capacity(100, 101) == 1100);
+        REQUIRE(chunked.next_capacity(100, 5000) == 5000);
+        const Lud::growth_policy paged{.round_to = 4096};
+        REQUIRE(paged.next_capacity(4096, 4097) == 8192);
+        REQUIRE(paged.next_capacity(0, 1) == 4096);
+
+        std::vector<uint8_t> vec;
+        {
+            Lud::vector_ostream out(vec, std::ios::out, chunked);
+            out << std::string(10, 'a');
+            REQUIRE(vec.capacity() == 1000);
+            out << std::string(1500, 'b');
+            REQUIRE(vec.capacity() == 2000);
+        }
+        REQUIRE(vec.size() == 1510);
+
+        std::vector<uint8_t> written;
+        {
+            Lud::byte_writer writer(written, paged);
+            writer.write<uint32_t>(1);
+            REQUIRE(written.capacity() == 4096);
+        }
+        REQUIRE(written.size() == 4);
+    }
+
+    SECTION("Reads see writes before they are published")
+    {
+        std::vector<uint8_t> vec = {'a', 'b'};
+        Lud::vector_wrap_streambuf<uint8_t> buf(vec, std::ios::in | std::ios::out | std::ios::app);
+        std::iostream stream(&buf);
+        stream << "cd";
+        std::string all;
+        stream >> all;
+        REQUIRE(all == "abcd");
+        stream.clear();
+        stream << "e";
+        REQUIRE(stream.get() == 'e');
+        stream.seekp(0, std::ios::end);
+        REQUIRE(std::string(vec.begin(), vec.end()) == "abcde");
+        // append mode keeps the original contents
+        REQUIRE_THROWS_AS(buf.pubseekoff(-4, std::ios::end, std::ios::out), std::range_error);
+    }
+}
+
+TEST_CASE("Streams over buffers past 4 GiB", "[mem_stream][mmap]")
+{
+    // sparse, only the pages holding the markers take space
+    constexpr uint64_t size = (uint64_t{1} << 32) + 4096;
+    constexpr uint64_t far = (uint64_t{1} << 32) + 100;
+    const temp_file file("ludutils_sparse.bin", "");
+    std::filesystem::resize_file(file.path, size);
+    {
+        std::fstream out(file.path, std::ios::in | std::ios::out | std::ios::binary);
+        out.seekp(static_cast<std::streamoff>(far));
+        out << "far";
+        out.seekp(static_cast<std::streamoff>(size - 3));
+        out << "end";
+    }
+
+    Lud::mapped_file mapped(file.path, Lud::access_hint::random);
+    REQUIRE(mapped.size() == size);
+    Lud::memory_istream view_stream(mapped.bytes());
+    Lud::mmap_istream mmap_stream(std::move(mapped));
+
+    for (std::istream* stream : {static_cast<std::istream*>(&view_stream), static_cast<std::istream*>(&mmap_stream)})
+    {
+        REQUIRE(stream->rdbuf()->in_avail() == static_cast<std::streamsize>(size));
+
+        char buf[4]{};
+        stream->seekg(static_cast<std::streamoff>(far));
+        stream->read(buf, 3);
+        REQUIRE(std::string_view(buf, 3) == "far");
+        REQUIRE(static_cast<uint64_t>(stream->tellg()) == far + 3);
+
+        // back over the 4 GiB and 2 GiB marks and forward again
+        stream->seekg(-static_cast<std::streamoff>(far + 3), std::ios::cur);
+        REQUIRE(stream->tellg() == 0);
+        stream->seekg(static_cast<std::streamoff>(far), std::ios::cur);
+        REQUIRE(stream->peek() == 'f');
+
+        stream->seekg(-3, std::ios::end);
+        stream->read(buf, 3);
+        REQUIRE(std::string_view(buf, 3) == "end");
+        REQUIRE(stream->peek() == std::char_traits<char>::eof());
+        stream->clear();
+
+        stream->seekg(static_cast<std::streamoff>(size + 1));
+        REQUIRE(stream->fail());
+        stream->clear();
+    }
+}
+
+TEST_CASE("Byte cursors", "[mem_stream]")
+{
+    std::vector<uint8_t> buffer = {0xAA};
+    Lud::byte_writer writer(buffer);
+    writer.put(0x01);
+    // length patched in once the payload is written
+    const size_t length_at = writer.position();
+    writer.write<uint32_t>(0);
+    const std::array<uint16_t, 2> values = {0x1234, 0x5678};
+    writer.write_span(std::span(values));
+    writer.write(0x0102030405060708ull, std::endian::big);
+    writer.write(2.5, std::endian::little);
+    const size_t end = writer.position();
+    writer.seek(length_at);
+    writer.write(static_cast<uint32_t>(end - length_at - 4), std::endian::big);
+    REQUIRE(writer.size() == end);
+    REQUIRE(writer.buffer().size() == end);
+    REQUIRE(buffer[0] == 0xAA);
+    REQUIRE(buffer[17] == 0x08);
+    REQUIRE_THROWS_AS(writer.seek(end + 1), std::out_of_range);
+
+    SECTION("Reads back what was written")
+    {
+        auto reader = writer.reader();
+        reader.skip(1);
+        REQUIRE(reader.get() == 0x01);
+        REQUIRE(reader.read<uint32_t>(std::endian::big) == 20);
+        std::array<uint16_t, 2> read_values{};
+        reader.read_into(std::span(read_values));
+        REQUIRE(read_values == values);
+        REQUIRE(reader.read<uint64_t>(std::endian::big) == 0x0102030405060708ull);
+        REQUIRE(reader.read<double>(std::endian::little) == 2.5);
+        REQUIRE(reader.at_end());
+
+        reader.seek(2);
+        REQUIRE(reader.read_view(4).data() == buffer.data() + 2);
+    }
+
+    SECTION("Bounds check modes")
+    {
+        const std::span<const uint8_t> data(buffer.data(), 6);
+
+        Lud::byte_reader throwing(data);
+        throwing.skip(4);
+        REQUIRE_THROWS_AS(throwing.read<uint32_t>(), std::out_of_range);
+        REQUIRE(throwing.position() == 4);
+        REQUIRE_THROWS_AS(throwing.seek(7), std::out_of_range);
+
+        Lud::byte_reader<uint8_t, Lud::bounds_check::flag> flagged(data);
+        flagged.skip(4);
+        REQUIRE(flagged.read<uint32_t>() == 0);
+        REQUIRE(flagged.failed());
+        // sticky until cleared, even for reads that would fit
+        REQUIRE(flagged.get() == 0);
+        REQUIRE(flagged.position() == 4);
+        flagged.clear();
+        REQUIRE(flagged.read<uint16_t>(std::endian::big) == 20);
+        REQUIRE_FALSE(flagged.failed());
+        REQUIRE(flagged.read_view(1).empty());
+        REQUIRE(flagged.failed());
+
+        Lud::byte_reader<uint8_t, Lud::bounds_check::none> unchecked(data);
+        unchecked.skip(2);
+        REQUIRE(unchecked.read<uint32_t>(std::endian::big) == 20);
+        REQUIRE(unchecked.at_end());
+    }
+
+    SECTION("Cut back to what was written")
+    {
+        std::vector<uint8_t> out;
+        {
+            Lud::byte_writer scoped(out);
+            scoped.write<uint16_t>(1);
+            REQUIRE(out.size() >= 2);
+        }
+        REQUIRE(out.size() == 2);
+    }
+
+    SECTION("Reserving and flushing do not fill the capacity")
+    {
+        std::vector<uint8_t> out;
+        Lud::byte_writer scoped(out);
+        scoped.reserve(size_t{1} << 20);
+        scoped.write<uint32_t>(1);
+        // a little room past the write, not the whole reservation
+        REQUIRE(out.size() >= 4);
+        REQUIRE(out.size() < 4096);
+        REQUIRE(scoped.buffer().size() == 4);
+        scoped.write<uint64_t>(2);
+        REQUIRE(out.size() >= 12);
+        REQUIRE(out.size() < 4096);
+        REQUIRE(out.capacity() >= size_t{1} << 20);
+    }
+
+    SECTION("Same buffer through the std streams")
+    {
+        auto in = writer.istream();
+        in.seekg(2);
+        uint8_t length[4];
+        in.read(reinterpret_cast<char*>(length), 4);
+        REQUIRE(length[3] == 20);
+
+        auto reader = writer.reader();
+        reader.skip(6);
+        auto rest = reader.istream();
+        REQUIRE(rest.read<uint16_t>() == 0x1234);
+    }
+}
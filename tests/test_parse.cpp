@@ -3,6 +3,8 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <sstream>
+
 TEST_CASE("String Split", "[parse][strings]")
 {
     SECTION("Simple split")
@@ -80,6 +82,360 @@ TEST_CASE("String Split", "[parse][strings]")
         auto parts = Lud::Split("This is a test", ' ');
         REQUIRE(parts.size() == 4);
     }
+
+    SECTION("delim is char, long input")
+    {
+        std::string input;
+        for (size_t i = 0; i < 300; i++)
+        {
+            input += (i % 7 == 0 || i % 11 == 0) ? ',' : static_cast<char>('a' + i % 26);
+        }
+        for (size_t len = 0; len < input.size(); len += 13)
+        {
+            const std::string_view sub(input.data(), len);
+            for (size_t n : {0, 1, 5, 40})
+            {
+                std::vector<std::string_view> expected;
+                std::ranges::copy(Lud::split_view(sub, ',', n), std::back_inserter(expected));
+                REQUIRE(Lud::Split(sub, ',', n) == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Split into inline storage", "[parse][strings][containers]")
+{
+    SECTION("SplitN")
+    {
+        constexpr auto parts = Lud::SplitN<2>("a b c d", ' ');
+        STATIC_REQUIRE(parts.size() == 3);
+        STATIC_REQUIRE(parts[2] == "c d");
+
+        const auto fraction = Lud::SplitN<1>("1 / 2", " / ");
+        REQUIRE(fraction.size() == 2);
+        REQUIRE(fraction[0] == "1");
+        REQUIRE(fraction[1] == "2");
+        REQUIRE(Lud::SplitN<3>("", ',').empty());
+    }
+
+    SECTION("small_vector stays inline")
+    {
+        const auto parts = Lud::Split<Lud::small_vector<std::string_view, 4>>("This is a test", ' ');
+        REQUIRE(parts.is_inline());
+        REQUIRE(parts == Lud::small_vector<std::string_view, 4>{"This", "is", "a", "test"});
+    }
+
+    SECTION("small_vector spills to the heap")
+    {
+        const std::string_view str = "a b c d e f g h i j";
+        const auto parts = Lud::Split<Lud::small_vector<std::string_view, 4>>(str, ' ');
+        REQUIRE_FALSE(parts.is_inline());
+        REQUIRE(std::ranges::equal(parts, Lud::Split(str, ' ')));
+    }
+
+    SECTION("small_vector of owning elements")
+    {
+        Lud::small_vector<std::string, 2> vec;
+        vec.push_back("a long string that does not fit in the small string buffer");
+        vec.emplace_back(3, 'x');
+        REQUIRE(vec.is_inline());
+        vec.push_back(vec[0]);
+        REQUIRE_FALSE(vec.is_inline());
+        REQUIRE(vec[2] == vec[0]);
+        vec.insert(vec.begin(), "front");
+        vec.insert(vec.begin() + 2, "middle");
+        REQUIRE(vec.size() == 5);
+        REQUIRE(vec[0] == "front");
+        REQUIRE(vec[2] == "middle");
+        REQUIRE(vec[3] == "xxx");
+
+        auto copy = vec;
+        REQUIRE(copy == vec);
+        auto moved = std::move(copy);
+        REQUIRE(moved == vec);
+        REQUIRE(copy.empty());
+
+        Lud::small_vector<std::string, 2> small{"one", "two"};
+        Lud::small_vector<std::string, 2> moved_small = std::move(small);
+        REQUIRE(moved_small.is_inline());
+        REQUIRE(moved_small[1] == "two");
+        REQUIRE(small.empty());
+
+        moved = moved_small;
+        REQUIRE(moved == moved_small);
+        moved.pop_back();
+        REQUIRE(moved.back() == "one");
+        moved.clear();
+        REQUIRE(moved.empty());
+    }
+}
+
+TEST_CASE("String split_view", "[parse][strings]")
+{
+    const auto collect = [](auto&& view) {
+        std::vector<std::string_view> res;
+        for (auto token : view)
+        {
+            res.push_back(token);
+        }
+        return res;
+    };
+
+    SECTION("Simple split")
+    {
+        auto parts = collect(Lud::split_view("This is a test", ' '));
+        REQUIRE(parts == std::vector<std::string_view>{"This", "is", "a", "test"});
+    }
+
+    SECTION("Same as Split")
+    {
+        const std::vector<std::string_view> inputs{
+            "", "   ", "This is a test", "  This  is a test  ", "a,,b,,,c", ",a,b,", "This is a test"
+        };
+        for (const auto input : inputs)
+        {
+            for (size_t n = 0; n < 5; n++)
+            {
+                REQUIRE(collect(Lud::split_view(input, ' ', n)) == Lud::Split(input, ' ', n));
+                REQUIRE(collect(Lud::split_view(input, ',', n)) == Lud::Split(input, ',', n));
+                REQUIRE(collect(Lud::split_view(input, "is", n)) == Lud::Split(input, "is", n));
+                REQUIRE(collect(Lud::split_view(input, ",,", n)) == Lud::Split(input, ",,", n));
+            }
+        }
+    }
+
+    SECTION("Empty delim")
+    {
+        auto parts = collect(Lud::split_view("This is a test", ""));
+        REQUIRE(parts.size() == 1);
+        REQUIRE(parts[0] == "This is a test");
+    }
+
+    SECTION("Split once")
+    {
+        auto parts = collect("This is a test" | Lud::views::split_sv("is", 1));
+        REQUIRE(parts.size() == 2);
+        REQUIRE(parts[0] == "Th");
+        REQUIRE(parts[1] == " is a test");
+    }
+
+    SECTION("Transform pipeline")
+    {
+        std::string_view line = "1, 2,3 , 4";
+        auto view = line | Lud::views::split_sv(',') | std::views::transform(Lud::parse_integer<int>{});
+
+        std::vector<int> res;
+        std::ranges::copy(view, std::back_inserter(res));
+        REQUIRE(res == std::vector{1, 2, 3, 4});
+    }
+
+    SECTION("Is a forward range")
+    {
+        STATIC_REQUIRE(std::ranges::forward_range<Lud::split_view<char>>);
+        STATIC_REQUIRE(std::ranges::view<Lud::split_view<std::string_view>>);
+
+        auto view = Lud::split_view("a b c", ' ');
+        REQUIRE(std::ranges::distance(view) == 3);
+        REQUIRE(*std::ranges::next(view.begin()) == "b");
+    }
+}
+
+TEST_CASE("CSV reader", "[parse][strings][csv]")
+{
+    const auto read_all = [](Lud::csv_reader& reader) {
+        std::vector<std::vector<std::string>> records;
+        while (reader.next())
+        {
+            records.emplace_back(reader.fields().begin(), reader.fields().end());
+        }
+        return records;
+    };
+    using records = std::vector<std::vector<std::string>>;
+
+    SECTION("Unquoted")
+    {
+        Lud::csv_reader reader("a,b,c\n1,2,3\n");
+        REQUIRE(read_all(reader) == records{{"a", "b", "c"}, {"1", "2", "3"}});
+    }
+
+    SECTION("Line endings")
+    {
+        Lud::csv_reader crlf("a,b\r\nc,d");
+        REQUIRE(read_all(crlf) == records{{"a", "b"}, {"c", "d"}});
+        Lud::csv_reader cr("a,b\rc,d\r");
+        REQUIRE(read_all(cr) == records{{"a", "b"}, {"c", "d"}});
+    }
+
+    SECTION("Empty fields")
+    {
+        Lud::csv_reader reader(",a,,\n\n\"\"");
+        REQUIRE(read_all(reader) == records{{"", "a", "", ""}, {""}, {""}});
+        Lud::csv_reader empty("");
+        REQUIRE_FALSE(empty.next());
+    }
+
+    SECTION("Quoted")
+    {
+        Lud::csv_reader reader("\"a,b\",\"line\r\nbreak\"\n\"say \"\"hi\"\"\",\"\"\"\"\"\"\n");
+        REQUIRE(read_all(reader) == records{{"a,b", "line\r\nbreak"}, {"say \"hi\"", "\"\""}});
+    }
+
+    SECTION("Zero copy")
+    {
+        const std::string_view input = "plain,\"quoted\",\"esc\"\"aped\"";
+        Lud::csv_reader reader(input);
+        REQUIRE(reader.next());
+        const auto& fields = reader.fields();
+        REQUIRE(fields.size() == 3);
+        REQUIRE(fields[0].data() == input.data());
+        REQUIRE(fields[1].data() == input.data() + 7);
+        REQUIRE(fields[2] == "esc\"aped");
+        const bool in_input = std::less_equal<>{}(input.data(), fields[2].data()) && std::less<>{}(fields[2].data(), input.data() + input.size());
+        REQUIRE_FALSE(in_input);
+    }
+
+    SECTION("Custom delimiter and quote")
+    {
+        Lud::csv_reader reader("a;'b;c';'d''e'", ';', '\'');
+        REQUIRE(read_all(reader) == records{{"a", "b;c", "d'e"}});
+    }
+
+    SECTION("Span of bytes")
+    {
+        const std::vector<uint8_t> bytes{'x', ',', 'y', '\n'};
+        Lud::csv_reader reader{std::span<const uint8_t>(bytes)};
+        REQUIRE(read_all(reader) == records{{"x", "y"}});
+    }
+
+    SECTION("Offset")
+    {
+        Lud::csv_reader reader("a\nbc\n");
+        REQUIRE(reader.next());
+        REQUIRE(reader.offset() == 0);
+        REQUIRE(reader.next());
+        REQUIRE(reader.offset() == 2);
+    }
+
+    SECTION("Malformed")
+    {
+        Lud::csv_reader unterminated("a,\"bc");
+        REQUIRE_THROWS_AS(unterminated.next(), std::invalid_argument);
+        Lud::csv_reader trailing("\"a\"b,c");
+        REQUIRE_THROWS_AS(trailing.next(), std::invalid_argument);
+        // the offset is the opening quote, not one of the doubled quotes after it
+        Lud::csv_reader doubled("x,\"a\"\"b");
+        REQUIRE_THROWS_WITH(doubled.next(), "csv_reader: unterminated quoted field at offset 2");
+    }
+
+    SECTION("Long input")
+    {
+        records expected;
+        std::string input;
+        for (size_t i = 0; i < 300; i++)
+        {
+            std::vector<std::string> record;
+            for (size_t j = 0; j < i % 7 + 1; j++)
+            {
+                std::string field(i * j % 41, static_cast<char>('a' + (i + j) % 26));
+                if ((i + j) % 5 == 0)
+                {
+                    field += "\"x,\n";
+                }
+                record.push_back(field);
+                if (j != 0)
+                {
+                    input += ',';
+                }
+                if ((i + j) % 5 == 0)
+                {
+                    input += '"' + Lud::Replace(field, "\"", "\"\"") + '"';
+                }
+                else
+                {
+                    input += field;
+                }
+            }
+            input += i % 2 ? "\r\n" : "\n";
+            expected.push_back(record);
+        }
+        Lud::csv_reader reader(input);
+        REQUIRE(read_all(reader) == expected);
+    }
+}
+
+TEST_CASE("Line index", "[parse][strings]")
+{
+    SECTION("Lines")
+    {
+        Lud::line_index index("first\r\nsecond\n\nfourth\r\n");
+        REQUIRE(index.size() == 4);
+        REQUIRE(index[0] == "first");
+        REQUIRE(index[1] == "second");
+        REQUIRE(index[2] == "");
+        REQUIRE(index[3] == "fourth");
+        REQUIRE(index.offset(1) == 7);
+        REQUIRE(index.line_of(0) == 0);
+        REQUIRE(index.line_of(6) == 0);
+        REQUIRE(index.line_of(7) == 1);
+        REQUIRE(index.line_of(100) == 3);
+        REQUIRE_FALSE(index.is_wide());
+    }
+
+    SECTION("Empty and unterminated")
+    {
+        REQUIRE(Lud::line_index("").empty());
+        REQUIRE(Lud::line_index("\n").size() == 1);
+
+        Lud::line_index index("a\rb");
+        REQUIRE(index.size() == 1);
+        REQUIRE(index[0] == "a\rb");
+    }
+
+    SECTION("Long input")
+    {
+        std::string input;
+        std::vector<std::string> expected;
+        for (int i = 0; i < 2000; i++)
+        {
+            expected.emplace_back(i % 37, static_cast<char>('a' + i % 26));
+            input += expected.back();
+            input += i % 3 ? "\n" : "\r\n";
+        }
+        Lud::line_index index(input);
+        REQUIRE(index.size() == expected.size());
+        for (size_t i = 0; i < index.size(); i++)
+        {
+            REQUIRE(index[i] == expected[i]);
+            REQUIRE(index.line_of(index.offset(i) + index[i].size()) == i);
+        }
+    }
+
+    SECTION("Tailing a growing buffer")
+    {
+        const std::string_view input = "one\r\ntwo\nthree\r\n\r\nfive";
+        std::string log;
+        Lud::line_index index;
+        // appended a byte at a time, so every line break is split across updates
+        for (char c : input)
+        {
+            log += c;
+            index.update(log);
+        }
+        REQUIRE(index.size() == 5);
+        REQUIRE(index[1] == "two");
+        REQUIRE(index[3] == "");
+        REQUIRE(index[4] == "five");
+
+        log += "\r";
+        index.update(log);
+        REQUIRE(index[4] == "five");
+        log += "\nsix";
+        index.update(log);
+        REQUIRE(index.size() == 6);
+        REQUIRE(index[5] == "six");
+
+        REQUIRE_THROWS_AS(index.update("one"), std::invalid_argument);
+    }
 }
 
 TEST_CASE("String Join", "[parse][strings]")
@@ -115,6 +471,63 @@ TEST_CASE("String Join", "[parse][strings]")
         auto full3 = Lud::Join(parts.end(), parts.end(), " ");
         REQUIRE(full3 == "");
     }
+
+    SECTION("Input iterator")
+    {
+        std::istringstream stream("This is a test");
+        auto full = Lud::Join(std::istream_iterator<std::string>(stream), std::istream_iterator<std::string>(), '_');
+        REQUIRE(full == "This_is_a_test");
+    }
+
+    SECTION("Join to reused buffer")
+    {
+        std::vector<std::string_view> parts{"This", "is", "a", "test"};
+        std::string buffer;
+        buffer.reserve(64);
+        const char* data = buffer.data();
+
+        Lud::JoinTo(buffer, parts, " ");
+        REQUIRE(buffer == "This is a test");
+
+        Lud::JoinTo(buffer, parts, ',');
+        REQUIRE(buffer == "This is a testThis,is,a,test");
+
+        buffer.clear();
+        Lud::JoinTo(buffer, parts.begin() + 2, parts.end(), "--");
+        REQUIRE(buffer == "a--test");
+        REQUIRE(buffer.data() == data);
+    }
+
+    SECTION("Join to growing buffer")
+    {
+        std::vector<std::string_view> parts{"growing", "past", "the", "small", "buffer"};
+        std::string buffer;
+        Lud::JoinTo(buffer, parts, ' ');
+        REQUIRE(buffer == "growing past the small buffer");
+    }
+
+    SECTION("Join to buffer from made up strings")
+    {
+        const std::vector<int> numbers{1, 22, 333};
+        int calls = 0;
+        auto strings = numbers | std::views::transform([&](int n) {
+                           calls++;
+                           return std::to_string(n);
+                       });
+        std::string buffer;
+        Lud::JoinTo(buffer, strings.begin(), strings.end(), ", ");
+        REQUIRE(buffer == "1, 22, 333");
+        // each element is built once
+        REQUIRE(calls == 3);
+    }
+
+    SECTION("Join to output iterator")
+    {
+        std::vector<std::string> parts{"This", "is", "a", "test"};
+        std::array<char, 32> buffer{};
+        auto end = Lud::JoinTo(buffer.begin(), parts.begin(), parts.end(), ", ");
+        REQUIRE(std::string_view(buffer.begin(), end) == "This, is, a, test");
+    }
 }
 
 TEST_CASE("Remove Prefix", "[parse][strings]")
@@ -347,6 +760,54 @@ TEST_CASE("To title", "[parse][strings]")
     }
 }
 
+TEST_CASE("Case conversion long input", "[parse][strings]")
+{
+    std::string original;
+    for (size_t i = 0; i < 200; i++)
+    {
+        original += static_cast<char>(i % 5 == 0 ? ' ' : 32 + (i * 37) % 95);
+    }
+    // non ASCII bytes are left to the locale, the default "C" locale leaves them untouched
+    original += "\xc3\xa1\xc3\x81 mixed \xe2\x82\xac block";
+    original += original;
+
+    const auto reference = [&](auto fn) {
+        std::string res = original;
+        for (char& c : res)
+        {
+            c = static_cast<char>(fn(static_cast<unsigned char>(c)));
+        }
+        return res;
+    };
+
+    SECTION("Upper")
+    {
+        REQUIRE(Lud::ToUpper(original) == reference(::toupper));
+    }
+
+    SECTION("Lower")
+    {
+        REQUIRE(Lud::ToLower(original) == reference(::tolower));
+    }
+
+    SECTION("Title")
+    {
+        std::string expected = original;
+        bool prev_ws = true;
+        for (char& c : expected)
+        {
+            const bool ws = c == ' ' || c == '\t' || c == '\n' || c == '\r';
+            if (!ws && prev_ws)
+            {
+                c = static_cast<char>(::toupper(static_cast<unsigned char>(c)));
+            }
+            prev_ws = ws;
+        }
+        REQUIRE(Lud::ToTitle(original) == expected);
+        REQUIRE(Lud::ToTitle("  many\t\tspaced   words\n") == "  Many\t\tSpaced   Words\n");
+    }
+}
+
 TEST_CASE("Capitalize", "[parse][strings]")
 {
     SECTION("Simple")
@@ -554,6 +1015,84 @@ TEST_CASE("Strip", "[parse][strings]")
     }
 }
 
+TEST_CASE("Strip long input", "[parse][strings]")
+{
+    SECTION("Matches find based strip")
+    {
+        const std::string_view delims = "\t\n\r ";
+        for (size_t lead = 0; lead < 70; lead += 3)
+        {
+            for (size_t trail = 0; trail < 70; trail += 5)
+            {
+                std::string str;
+                for (size_t i = 0; i < lead; i++)
+                {
+                    str += delims[i % delims.size()];
+                }
+                str += "a b\tc";
+                for (size_t i = 0; i < trail; i++)
+                {
+                    str += delims[i % delims.size()];
+                }
+
+                const auto first = str.find_first_not_of(delims);
+                const auto last = str.find_last_not_of(delims);
+                REQUIRE(Lud::LStrip(str) == std::string_view(str).substr(first));
+                REQUIRE(Lud::RStrip(str) == std::string_view(str).substr(0, last + 1));
+                REQUIRE(Lud::Strip(str) == "a b\tc");
+                REQUIRE(!Lud::IsBlank(str));
+            }
+        }
+    }
+
+    SECTION("Blank")
+    {
+        for (size_t len = 0; len < 70; len++)
+        {
+            const std::string str(len, ' ');
+            REQUIRE(Lud::IsBlank(str));
+            REQUIRE(Lud::Strip(str).empty());
+            REQUIRE(Lud::LStrip(str).empty());
+            REQUIRE(Lud::RStrip(str).empty());
+        }
+        REQUIRE(!Lud::IsBlank(std::string(40, ' ') + "\v"));
+    }
+}
+
+TEST_CASE("Strip benchmark", "[.][benchmark][parse][strings]")
+{
+    const auto find_strip = [](const std::string_view str) -> std::string_view {
+        const auto delims = "\t\n\r ";
+        const size_t begin = str.find_first_not_of(delims);
+        const size_t end = str.find_last_not_of(delims);
+        if (begin == std::string_view::npos)
+        {
+            return {};
+        }
+        return str.substr(begin, end - begin + 1);
+    };
+
+    const std::string short_str = "  1234 ";
+    const std::string long_str = std::string(256, ' ') + "1234" + std::string(256, '\t');
+
+    BENCHMARK("find_first_not_of, short")
+    {
+        return find_strip(short_str);
+    };
+    BENCHMARK("Lud::Strip, short")
+    {
+        return Lud::Strip(short_str);
+    };
+    BENCHMARK("find_first_not_of, long")
+    {
+        return find_strip(long_str);
+    };
+    BENCHMARK("Lud::Strip, long")
+    {
+        return Lud::Strip(long_str);
+    };
+}
+
 TEST_CASE("Reverse", "[parse][strings]")
 {
     SECTION("Simple")
@@ -574,6 +1113,427 @@ TEST_CASE("Reverse", "[parse][strings]")
     }
 }
 
+TEST_CASE("Transforms into caller buffers", "[parse][strings]")
+{
+    const std::string input = "  hello wORLD, this is\ta test  ";
+
+    SECTION("Same as the allocating versions")
+    {
+        std::string buffer;
+        std::array<char, 64> array{};
+        std::string iter;
+
+        const auto check = [&](const std::string& expected, auto to_string, auto to_span, auto to_iter) {
+            buffer.clear();
+            REQUIRE(to_string(buffer) == expected);
+            const std::span<char> written = to_span(std::span<char>(array));
+            REQUIRE(std::string_view(written.data(), written.size()) == expected);
+            iter.clear();
+            to_iter(std::back_inserter(iter));
+            REQUIRE(iter == expected);
+        };
+
+        check(
+            Lud::ToUpper(input),
+            [&](std::string& out) -> std::string& { return Lud::ToUpper(out, input); },
+            [&](std::span<char> out) { return Lud::ToUpper(out, input); },
+            [&](auto out) { return Lud::ToUpper(out, input); }
+        );
+        check(
+            Lud::ToLower(input),
+            [&](std::string& out) -> std::string& { return Lud::ToLower(out, input); },
+            [&](std::span<char> out) { return Lud::ToLower(out, input); },
+            [&](auto out) { return Lud::ToLower(out, input); }
+        );
+        check(
+            Lud::ToTitle(input),
+            [&](std::string& out) -> std::string& { return Lud::ToTitle(out, input); },
+            [&](std::span<char> out) { return Lud::ToTitle(out, input); },
+            [&](auto out) { return Lud::ToTitle(out, input); }
+        );
+        check(
+            Lud::Capitalize(input),
+            [&](std::string& out) -> std::string& { return Lud::Capitalize(out, input); },
+            [&](std::span<char> out) { return Lud::Capitalize(out, input); },
+            [&](auto out) { return Lud::Capitalize(out, input); }
+        );
+        check(
+            Lud::Reverse(input),
+            [&](std::string& out) -> std::string& { return Lud::Reverse(out, input); },
+            [&](std::span<char> out) { return Lud::Reverse(out, input); },
+            [&](auto out) { return Lud::Reverse(out, input); }
+        );
+        check(
+            Lud::Replace(input, "is", "IS!"),
+            [&](std::string& out) -> std::string& { return Lud::Replace(out, input, "is", "IS!"); },
+            [&](std::span<char> out) { return Lud::Replace(out, input, "is", "IS!"); },
+            [&](auto out) { return Lud::Replace(out, input, "is", "IS!"); }
+        );
+        check(
+            Lud::Replace(input, ' ', '_'),
+            [&](std::string& out) -> std::string& { return Lud::Replace(out, input, ' ', '_'); },
+            [&](std::span<char> out) { return Lud::Replace(out, input, ' ', '_'); },
+            [&](auto out) { return Lud::Replace(out, input, ' ', '_'); }
+        );
+    }
+
+    SECTION("String buffer is appended to and reused")
+    {
+        std::string buffer;
+        buffer.reserve(256);
+        const char* data = buffer.data();
+        Lud::ToUpper(buffer, "abc");
+        Lud::ToLower(buffer, "DEF");
+        REQUIRE(buffer == "ABCdef");
+        buffer.clear();
+        Lud::Replace(buffer, input, "t", "T");
+        REQUIRE(buffer == Lud::Replace(input, "t", "T"));
+        REQUIRE(buffer.data() == data);
+    }
+
+    SECTION("Input viewing the output string")
+    {
+        std::string buffer = "abc def";
+        Lud::ToTitle(buffer, buffer);
+        REQUIRE(buffer == "abc defAbc Def");
+        Lud::Replace(buffer, std::string_view(buffer).substr(0, 3), "b", buffer);
+        REQUIRE(buffer == "abc defAbc Defaabc defAbc Defc");
+    }
+
+    SECTION("Span too small")
+    {
+        std::array<char, 4> small{};
+        REQUIRE_THROWS_AS(Lud::ToUpper(std::span<char>(small), "hello"), std::length_error);
+        REQUIRE_THROWS_AS(Lud::Replace(std::span<char>(small), "abcb", "b", "bb"), std::length_error);
+        REQUIRE(Lud::Replace(std::span<char>(small), "abcb", "b", "").size() == 2);
+    }
+}
+
+TEST_CASE("Replace", "[parse][strings]")
+{
+    SECTION("Simple")
+    {
+        std::string original = "This is a test";
+        auto res = Lud::Replace(original, "is", "IS");
+
+        REQUIRE(original == "This is a test");
+        REQUIRE(res == "ThIS IS a test");
+    }
+
+    SECTION("Result just past the small buffer")
+    {
+        REQUIRE(Lud::Replace("aaaaaaaaaaaaaaa", "a", "aa").size() == 30);
+        REQUIRE(Lud::Replace("aaaaaaaaaaaa\"x", "\"", "\"\"") == "aaaaaaaaaaaa\"\"x");
+    }
+
+    SECTION("Inplace, shrinking and growing")
+    {
+        std::string shrink = "a--b--c--";
+        std::string grow = "a-b-c-";
+        std::string same = "a-b-c-";
+        Lud::inplace::Replace(shrink, "--", "+");
+        Lud::inplace::Replace(grow, "-", "+++");
+        Lud::inplace::Replace(same, "-", "+");
+
+        REQUIRE(shrink == "a+b+c+");
+        REQUIRE(grow == "a+++b+++c+++");
+        REQUIRE(same == "a+b+c+");
+    }
+
+    SECTION("Replacement contains pattern")
+    {
+        std::string original = "aXa";
+        REQUIRE(Lud::Replace(original, "a", "aa") == "aaXaa");
+        REQUIRE(Lud::inplace::Replace(original, "a", "aa") == "aaXaa");
+    }
+
+    SECTION("Non overlapping, left to right")
+    {
+        REQUIRE(Lud::Replace("aaaaa", "aa", "b") == "bba");
+        REQUIRE(Lud::Replace("aab", "ab", "b") == "ab");
+    }
+
+    SECTION("Not found and empty")
+    {
+        std::string original = "This is a test";
+        REQUIRE(Lud::Replace(original, "not", "found") == original);
+        REQUIRE(Lud::Replace(original, "", "empty") == original);
+        REQUIRE(Lud::Replace("", "a", "b") == "");
+        REQUIRE(Lud::Replace(original, " ", "") == "Thisisatest");
+        REQUIRE(Lud::inplace::Replace(original, "", "empty") == "This is a test");
+    }
+
+    SECTION("Pattern from same buffer")
+    {
+        std::string original = "ab ab ab";
+        const std::string_view pattern(original.data(), 2);
+        Lud::inplace::Replace(original, pattern, "c");
+        REQUIRE(original == "c c c");
+    }
+
+    SECTION("Char")
+    {
+        REQUIRE(Lud::Replace("a-b-c", '-', '+') == "a+b+c");
+    }
+}
+
+TEST_CASE("ReplaceAll", "[parse][strings]")
+{
+    SECTION("Simple")
+    {
+        const Lud::replace_set set{{"<", "&lt;"}, {">", "&gt;"}, {"&", "&amp;"}};
+        REQUIRE(Lud::ReplaceAll("<a href=\"x&y\">", set) == "&lt;a href=\"x&amp;y\"&gt;");
+        REQUIRE(Lud::ReplaceAll("nothing to do", set) == "nothing to do");
+        REQUIRE(Lud::ReplaceAll("", set) == "");
+    }
+
+    SECTION("Leftmost longest")
+    {
+        REQUIRE(Lud::ReplaceAll("abcd", {{"bc", "X"}, {"abcd", "Y"}}) == "Y");
+        REQUIRE(Lud::ReplaceAll("abcx", {{"bc", "X"}, {"abcd", "Y"}}) == "aXx");
+        REQUIRE(Lud::ReplaceAll("abcd", {{"a", "1"}, {"ab", "2"}, {"abc", "3"}}) == "3d");
+        REQUIRE(Lud::ReplaceAll("aaaa", {{"aa", "b"}, {"a", "c"}}) == "bb");
+        REQUIRE(Lud::ReplaceAll("aaa", {{"aa", "b"}, {"a", "c"}}) == "bc");
+    }
+
+    SECTION("Replacements are not searched again")
+    {
+        REQUIRE(Lud::ReplaceAll("ab", {{"a", "b"}, {"b", "a"}}) == "ba");
+    }
+
+    SECTION("Matches reference implementation")
+    {
+        const std::vector<std::pair<std::string, std::string>> pairs{
+            {"he", "1"}, {"she", "2"}, {"his", "3"}, {"hers", "4"}, {"e", ""}, {"ushers", "5"}
+        };
+        const Lud::replace_set set(pairs);
+
+        const auto reference = [&](const std::string_view str) {
+            std::string res;
+            size_t pos = 0;
+            while (pos < str.size())
+            {
+                const std::pair<std::string, std::string>* best = nullptr;
+                for (const auto& pair : pairs)
+                {
+                    if (str.substr(pos).starts_with(pair.first) && (!best || pair.first.size() > best->first.size()))
+                    {
+                        best = &pair;
+                    }
+                }
+                if (best)
+                {
+                    res += best->second;
+                    pos += best->first.size();
+                }
+                else
+                {
+                    res += str[pos++];
+                }
+            }
+            return res;
+        };
+
+        const std::string_view alphabet = "ehrsuix";
+        std::string input;
+        for (size_t i = 0; i < 2000; i++)
+        {
+            input += alphabet[(i * i * 7 + i * 3) % alphabet.size()];
+        }
+        for (size_t len = 0; len < input.size(); len += 97)
+        {
+            const std::string_view sub(input.data(), len);
+            REQUIRE(Lud::ReplaceAll(sub, set) == reference(sub));
+        }
+        std::string inplace = input;
+        Lud::inplace::ReplaceAll(inplace, set);
+        REQUIRE(inplace == reference(input));
+    }
+}
+
+TEST_CASE("Contains any and all", "[parse][strings]")
+{
+    SECTION("Simple")
+    {
+        REQUIRE(Lud::ContainsAny("hello world", "xyz ") == true);
+        REQUIRE(Lud::ContainsAny("hello world", "xyz") == false);
+        REQUIRE(Lud::ContainsAny("hello world", "") == false);
+        REQUIRE(Lud::ContainsAny("", "abc") == false);
+
+        REQUIRE(Lud::ContainsAll("hello world", "world") == true);
+        REQUIRE(Lud::ContainsAll("hello world", "wordx") == false);
+        REQUIRE(Lud::ContainsAll("hello world", "") == true);
+        REQUIRE(Lud::ContainsAll("", "") == true);
+        REQUIRE(Lud::ContainsAll("", "a") == false);
+    }
+
+    SECTION("Set semantics")
+    {
+        REQUIRE(Lud::ContainsAll("aaa", "ab") == false);
+        REQUIRE(Lud::ContainsAll("ab", "aaabbb") == true);
+        REQUIRE(Lud::ContainsAll("ba", "ab") == true);
+    }
+
+    SECTION("char_set")
+    {
+        Lud::char_set set("hello");
+        REQUIRE(set.size() == 4);
+        REQUIRE(set.contains('h'));
+        REQUIRE(set.contains('o'));
+        REQUIRE_FALSE(set.contains('x'));
+        REQUIRE_FALSE(Lud::char_set().contains('\0'));
+        set.insert('\xff');
+        REQUIRE(set.contains('\xff'));
+        REQUIRE(set.size() == 5);
+        REQUIRE(Lud::ContainsAll("\xffhole", set));
+        REQUIRE_FALSE(Lud::ContainsAll("hole", set));
+    }
+
+    SECTION("Matches reference implementation")
+    {
+        std::string input;
+        for (size_t i = 0; i < 1000; i++)
+        {
+            input += static_cast<char>((i * i * 31 + i * 7) % 256);
+        }
+        const std::vector<std::string> patterns{
+            "a", "\x80", "\xff\x01", "0123456789", "\x7f\x80\x8f\xf0", std::string(1, '\0'), "zZ\x9c"
+        };
+        for (const auto& pattern : patterns)
+        {
+            const Lud::char_set set(pattern);
+            for (size_t start = 0; start < input.size(); start += 37)
+            {
+                for (size_t len : {size_t{0}, size_t{5}, size_t{16}, size_t{31}, size_t{33}, size_t{200}})
+                {
+                    const std::string_view sub = std::string_view(input).substr(start, len);
+                    const bool any = std::ranges::any_of(sub, [&](char c) { return pattern.contains(c); });
+                    const bool all = std::ranges::all_of(pattern, [&](char c) { return sub.contains(c); });
+                    REQUIRE(Lud::ContainsAny(sub, set) == any);
+                    REQUIRE(Lud::ContainsAll(sub, set) == all);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("CPU dispatch", "[parse][cpu]")
+{
+    SECTION("Table picks the best supported entry")
+    {
+        using fn_t = int (*)();
+        const Lud::dispatch_table<fn_t> table{
+            .scalar = [] { return 0; },
+            .sse2 = [] { return 1; },
+            .avx2 = [] { return 2; },
+        };
+        REQUIRE(table.select(Lud::cpu_features{})() == 0);
+        REQUIRE(table.select(Lud::cpu_features{.sse2 = true, .ssse3 = true})() == 1);
+        REQUIRE(table.select(Lud::cpu_features{.sse2 = true, .avx2 = true})() == 2);
+        // no avx512 entry, the next best one is used
+        REQUIRE(table.select(Lud::cpu_features{.sse2 = true, .avx2 = true, .avx512bw = true})() == 2);
+    }
+
+#if defined(LUD_CPU_X86) && defined(__GNUC__)
+    SECTION("Detection agrees with the compiler")
+    {
+        const auto features = Lud::DetectCpuFeatures();
+        REQUIRE(features.sse2 == static_cast<bool>(__builtin_cpu_supports("sse2")));
+        REQUIRE(features.ssse3 == static_cast<bool>(__builtin_cpu_supports("ssse3")));
+        REQUIRE(features.sse42 == static_cast<bool>(__builtin_cpu_supports("sse4.2")));
+        REQUIRE(features.avx2 == static_cast<bool>(__builtin_cpu_supports("avx2")));
+        REQUIRE(features.avx512bw == static_cast<bool>(__builtin_cpu_supports("avx512bw")));
+        REQUIRE(features.bmi2 == static_cast<bool>(__builtin_cpu_supports("bmi2")));
+    }
+#endif
+
+    SECTION("Every kernel the cpu supports agrees with scalar")
+    {
+        std::string input;
+        for (size_t i = 0; i < 777; i++)
+        {
+            input += static_cast<char>((i * i * 13 + i * 5) % (i % 11 == 0 ? 256 : 128));
+        }
+        using case_fn = void (*)(char*, size_t);
+        const auto check_case = [&](case_fn kernel, case_fn reference) {
+            for (size_t len = 0; len < input.size(); len += 61)
+            {
+                std::string a = input.substr(0, len);
+                std::string b = a;
+                kernel(a.data(), a.size());
+                reference(b.data(), b.size());
+                REQUIRE(a == b);
+            }
+        };
+        const auto check_set = [&](Lud::detail::find_in_set_fn kernel) {
+            for (const std::string_view chars : {"\x80\xf1", "xyz", "\x7f", "\t\n"})
+            {
+                const Lud::char_set set(chars);
+                for (size_t len = 0; len < input.size(); len += 61)
+                {
+                    const std::string_view sub = std::string_view(input).substr(len);
+                    REQUIRE(set.find_first(sub) == sub.find_first_of(chars));
+                    REQUIRE(set.find_first(sub, kernel) == sub.find_first_of(chars));
+                }
+            }
+        };
+        check_case(Lud::detail::convert_case<true>, Lud::detail::convert_case_scalar<true>);
+        check_set(Lud::detail::find_in_set_scalar);
+#if defined(LUD_SIMD_DISPATCH)
+        const auto features = Lud::DetectCpuFeatures();
+        if (features.sse2)
+        {
+            check_case(Lud::detail::convert_case_sse2<true>, Lud::detail::convert_case_scalar<true>);
+            check_case(Lud::detail::convert_case_sse2<false>, Lud::detail::convert_case_scalar<false>);
+        }
+        if (features.avx2)
+        {
+            check_case(Lud::detail::convert_case_avx2<true>, Lud::detail::convert_case_scalar<true>);
+            check_case(Lud::detail::convert_case_avx2<false>, Lud::detail::convert_case_scalar<false>);
+            check_set(Lud::detail::find_in_set_avx2);
+        }
+        if (features.ssse3)
+        {
+            check_set(Lud::detail::find_in_set_ssse3);
+            const auto* bytes = reinterpret_cast<const uint8_t*>(input.data());
+            for (size_t len = 0; len < 200; len++)
+            {
+                std::string a(len * 2, '\0');
+                std::string b(len * 2, '\0');
+                Lud::detail::hex_encode_ssse3(bytes, len, a.data(), true);
+                Lud::detail::hex_encode_scalar(bytes, len, b.data(), true);
+                REQUIRE(a == b);
+
+                a.assign((len + 2) / 3 * 4, '\0');
+                b.assign((len + 2) / 3 * 4, '\0');
+                Lud::detail::base64_encode_ssse3(bytes, len, a.data());
+                Lud::detail::base64_encode_scalar(bytes, len, b.data());
+                REQUIRE(a == b);
+            }
+            // every byte value at every position of a block, valid or not
+            for (size_t c = 0; c < 256; c++)
+            {
+                std::string hex(64, 'a');
+                std::string base64(64, 'A');
+                hex[c % 64] = static_cast<char>(c);
+                base64[c % 40] = static_cast<char>(c);
+                // what is written before a bad char is unspecified, the callers drop it
+                std::vector<uint8_t> a(32);
+                std::vector<uint8_t> b(32);
+                const size_t bad_hex = Lud::detail::hex_decode_ssse3(hex.data(), hex.size(), a.data());
+                REQUIRE(bad_hex == Lud::detail::hex_decode_scalar(hex.data(), hex.size(), b.data()));
+                REQUIRE((bad_hex != std::string_view::npos || a == b));
+                a.assign(48, 0);
+                b.assign(48, 0);
+                const size_t bad_base64 = Lud::detail::base64_decode_ssse3(base64.data(), base64.size(), a.data());
+                REQUIRE(bad_base64 == Lud::detail::base64_decode_scalar(base64.data(), base64.size(), b.data()));
+                REQUIRE((bad_base64 != std::string_view::npos || a == b));
+            }
+        }
+#endif
+    }
+}
+
 TEST_CASE("Is Num integer", "[parse][numbers][integer]")
 {
     SECTION("Simple")
@@ -616,6 +1576,63 @@ TEST_CASE("Is Num integer", "[parse][numbers][integer]")
         REQUIRE(Lud::is_num<uint8_t>("  377", 8).value() == 255);
     }
 }
+TEMPLATE_TEST_CASE("Is Num integer boundaries", "[parse][numbers][integer]", signed char, unsigned char, short, unsigned short, int, unsigned int, long, unsigned long, long long, unsigned long long)
+{
+    using N = TestType;
+    // decimal string + 1, only for non negative numbers
+    const auto increment = [](std::string str) {
+        size_t i = str.size();
+        while (i > 0 && str[i - 1] == '9')
+        {
+            str[--i] = '0';
+        }
+        if (i == 0)
+        {
+            return "1" + str;
+        }
+        str[i - 1]++;
+        return str;
+    };
+    const auto reference = [](const std::string_view str) -> std::optional<N> {
+        N val{};
+        const auto res = std::from_chars(str.data(), str.data() + str.size(), val);
+        if (res.ec != std::errc{} || res.ptr != str.data() + str.size())
+        {
+            return std::nullopt;
+        }
+        return val;
+    };
+
+    const std::string max = std::to_string(std::numeric_limits<N>::max());
+    const std::string min = std::to_string(std::numeric_limits<N>::min());
+    std::vector<std::string> cases{
+        max, increment(max), min, "0", "-0", "1", "-1", "00000000000000000000000000001", "-", "", "+1",
+        "1a", "a1", "12345678", "123456789", "1234567x9", "99999999999999999999", "184467440737095516150"
+    };
+    if constexpr (std::is_signed_v<N>)
+    {
+        cases.push_back("-" + increment(min.substr(1)));
+        cases.push_back("-" + increment(max));
+    }
+    else
+    {
+        cases.push_back("-" + max);
+    }
+
+    for (const auto& str : cases)
+    {
+        CAPTURE(str);
+        REQUIRE(Lud::is_num<N, 10>(str) == reference(str));
+        REQUIRE(Lud::is_num<N>(str) == reference(str));
+        REQUIRE(Lud::is_num<N, 10>("  " + str + "\t") == reference(str));
+    }
+
+    REQUIRE(Lud::is_num<N, 10>(max).value() == std::numeric_limits<N>::max());
+    REQUIRE(Lud::is_num<N, 10>(min).value() == std::numeric_limits<N>::min());
+    REQUIRE(!Lud::is_num<N, 10>(increment(max)));
+    REQUIRE(Lud::parse_integer<N>{}(max) == std::numeric_limits<N>::max());
+}
+
 TEST_CASE("Is Num Real", "[parse][numbers][real]")
 {
     SECTION("Simple")
@@ -642,6 +1659,410 @@ TEST_CASE("Is Num Real", "[parse][numbers][real]")
     }
 }
 
+TEST_CASE("Parse numbers", "[parse][numbers]")
+{
+    SECTION("Integers")
+    {
+        std::vector<int> out;
+        const auto res = Lud::ParseNumbers("1, 2,,-3 ,40", ',', out);
+        REQUIRE(res);
+        REQUIRE(res.count == 4);
+        REQUIRE(out == std::vector{1, 2, -3, 40});
+    }
+
+    SECTION("Reals with string delim")
+    {
+        std::vector<double> out;
+        const auto res = Lud::ParseNumbers("1.5 | 2 | -0.25", " | ", out);
+        REQUIRE(res);
+        REQUIRE(out == std::vector{1.5, 2.0, -0.25});
+    }
+
+    SECTION("Appends to existing storage")
+    {
+        std::vector<unsigned> out{7};
+        REQUIRE(Lud::ParseNumbers("8;9", ';', out));
+        REQUIRE(out == std::vector<unsigned>{7, 8, 9});
+    }
+
+    SECTION("First malformed token")
+    {
+        const std::string_view line = "1,2,x3,4";
+        std::vector<int> out;
+        const auto res = Lud::ParseNumbers(line, ',', out);
+        REQUIRE(!res);
+        REQUIRE(res.count == 2);
+        REQUIRE(res.error_token == 2);
+        REQUIRE(res.error_offset == 4);
+        REQUIRE(out == std::vector{1, 2});
+
+        std::vector<int> out_sv;
+        const auto res_sv = Lud::ParseNumbers(line, ",", out_sv);
+        REQUIRE(res_sv.error_token == 2);
+        REQUIRE(res_sv.error_offset == 4);
+
+        std::vector<uint8_t> small;
+        REQUIRE(Lud::ParseNumbers("255,256", ',', small).error_token == 1);
+    }
+
+    SECTION("Matches Split + transform")
+    {
+        std::string line;
+        for (int i = -500; i < 500; i++)
+        {
+            line += std::to_string(i * 7919) + (i % 3 == 0 ? ",," : ",");
+        }
+        std::vector<int> expected;
+        std::ranges::copy(Lud::Split(line, ',') | std::views::transform(Lud::parse_integer<int>{}), std::back_inserter(expected));
+
+        std::vector<int> out;
+        const auto res = Lud::ParseNumbers(line, ',', out);
+        REQUIRE(res);
+        REQUIRE(res.count == 1000);
+        REQUIRE(out == expected);
+    }
+}
+
+TEST_CASE("Parallel split and parse", "[parse][numbers][strings]")
+{
+    const Lud::parallel_options options{.threads = 4, .min_chunk_size = 16};
+
+    SECTION("Same as Split")
+    {
+        std::string input;
+        for (size_t i = 0; i < 3000; i++)
+        {
+            input += std::to_string(i * 7919 % 1000);
+            input += i % 3 == 0 ? ",," : i % 7 == 0 ? "ab\n" : ",";
+        }
+        REQUIRE(Lud::ParallelSplit(input, ',', options) == Lud::Split(input, ','));
+        REQUIRE(Lud::ParallelSplit(input, '\n', options) == Lud::Split(input, '\n'));
+        REQUIRE(Lud::ParallelSplit(input, "ab\n", options) == Lud::Split(input, "ab\n"));
+        REQUIRE(Lud::ParallelSplit(input, ",,", options) == Lud::Split(input, ",,"));
+        REQUIRE(Lud::ParallelSplit(input, "", options) == Lud::Split(input, ""));
+        REQUIRE(Lud::ParallelSplit(input, ',', {.threads = 64, .min_chunk_size = 1}) == Lud::Split(input, ','));
+        REQUIRE(Lud::ParallelSplit("", ',', options).empty());
+    }
+
+    SECTION("Chunks do not start inside a delimiter")
+    {
+        const std::string input(1000, 'a');
+        REQUIRE(Lud::ParallelSplit(input, "aa", options) == Lud::Split(input, "aa"));
+        REQUIRE(Lud::ParallelSplit(input + "b", "aaa", options) == Lud::Split(input + "b", "aaa"));
+    }
+
+    SECTION("Same as ParseNumbers")
+    {
+        std::string input;
+        for (int i = 0; i < 5000; i++)
+        {
+            input += std::to_string(i * 31 - 20000);
+            input += '\n';
+        }
+        std::vector<int> serial;
+        std::vector<int> parallel{1, 2, 3};
+        const auto serial_res = Lud::ParseNumbers(input, '\n', serial);
+        const auto parallel_res = Lud::ParallelParseNumbers(input, '\n', parallel, options);
+        REQUIRE(parallel_res);
+        REQUIRE(parallel_res.count == serial_res.count);
+        REQUIRE(std::vector<int>(parallel.begin() + 3, parallel.end()) == serial);
+
+        std::vector<double> reals;
+        REQUIRE(Lud::ParallelParseNumbers(input, "\n", reals, options).count == 5000);
+        REQUIRE(reals.back() == 4999 * 31 - 20000);
+    }
+
+    SECTION("Error is reported like ParseNumbers")
+    {
+        std::string input;
+        for (int i = 0; i < 2000; i++)
+        {
+            input += i == 1500 ? "oops" : std::to_string(i);
+            input += ' ';
+        }
+        std::vector<int> serial;
+        std::vector<int> parallel;
+        const auto serial_res = Lud::ParseNumbers(input, ' ', serial);
+        const auto parallel_res = Lud::ParallelParseNumbers(input, ' ', parallel, options);
+        REQUIRE_FALSE(parallel_res);
+        REQUIRE(parallel_res.count == serial_res.count);
+        REQUIRE(parallel_res.error_token == serial_res.error_token);
+        REQUIRE(parallel_res.error_offset == serial_res.error_offset);
+        REQUIRE(parallel == serial);
+    }
+}
+
+TEMPLATE_TEST_CASE("Format integer round trip", "[parse][numbers][integer]", int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t)
+{
+    using lim = std::numeric_limits<TestType>;
+    std::vector<TestType> values{lim::min(), lim::max(), 0, 1, 9, 10, 99, 100};
+    if constexpr (std::is_signed_v<TestType>)
+    {
+        for (const int64_t value : {int64_t{-1}, int64_t{-9}, int64_t{-10}, int64_t{-99}, int64_t{-100}, int64_t{lim::min() + 1}})
+        {
+            values.push_back(static_cast<TestType>(value));
+        }
+    }
+    uint64_t state = 0x9E3779B97F4A7C15;
+    for (size_t i = 0; i < 500; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        // shifted so every digit count shows up
+        values.push_back(static_cast<TestType>(state >> (state % 64)));
+    }
+
+    for (const auto value : values)
+    {
+        const std::string text = Lud::FormatInteger(value);
+        REQUIRE(text == std::to_string(value));
+        REQUIRE(Lud::is_num<TestType>(text) == value);
+    }
+
+    std::string buffer = "x";
+    Lud::FormatInteger(buffer, lim::max());
+    REQUIRE(buffer == "x" + std::to_string(lim::max()));
+
+    std::array<char, 24> array{};
+    const auto written = Lud::FormatInteger(std::span<char>(array), lim::min());
+    REQUIRE(std::string_view(written.data(), written.size()) == std::to_string(lim::min()));
+    std::array<char, 2> small{};
+    REQUIRE_THROWS_AS(Lud::FormatInteger(std::span<char>(small), TestType{100}), std::length_error);
+
+    const std::string joined = Lud::JoinNumbers(values, ", ");
+    std::vector<TestType> parsed;
+    REQUIRE(Lud::ParseNumbers(joined, ',', parsed));
+    REQUIRE(parsed == values);
+}
+
+TEMPLATE_TEST_CASE("Format real round trip", "[parse][numbers][real]", float, double)
+{
+    using lim = std::numeric_limits<TestType>;
+    std::vector<TestType> values{0, -0.0, 1, -1, 0.1, 1e-5, 123456.789, lim::min(), lim::max(), lim::lowest(), lim::denorm_min(), lim::epsilon()};
+    uint64_t state = 0x243F6A8885A308D3;
+    while (values.size() < 1000)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        using bits_t = std::conditional_t<sizeof(TestType) == 4, uint32_t, uint64_t>;
+        const auto value = std::bit_cast<TestType>(static_cast<bits_t>(state));
+        if (std::isfinite(value))
+        {
+            values.push_back(value);
+        }
+    }
+
+    for (const auto value : values)
+    {
+        const std::string text = Lud::FormatReal(value);
+        REQUIRE(text.size() <= Lud::detail::max_real_chars<TestType>);
+        const auto back = Lud::is_num<TestType>(text);
+        REQUIRE(back);
+        REQUIRE(std::bit_cast<std::conditional_t<sizeof(TestType) == 4, uint32_t, uint64_t>>(*back)
+                == std::bit_cast<std::conditional_t<sizeof(TestType) == 4, uint32_t, uint64_t>>(value));
+    }
+
+    REQUIRE(Lud::FormatReal(TestType{1.5}, std::chars_format::fixed, 3) == "1.500");
+    REQUIRE(Lud::FormatReal(lim::max(), std::chars_format::fixed, 2).size() > 40);
+    REQUIRE(Lud::FormatReal(std::numeric_limits<TestType>::infinity()) == "inf");
+
+    const std::string joined = Lud::JoinNumbers(values, '\n');
+    std::vector<TestType> parsed;
+    REQUIRE(Lud::ParseNumbers(joined, '\n', parsed));
+    REQUIRE(parsed.size() == values.size());
+    REQUIRE(std::ranges::equal(parsed, values, [](TestType a, TestType b) { return a == b && std::signbit(a) == std::signbit(b); }));
+}
+
+TEST_CASE("Compile time parsing", "[parse][constexpr]")
+{
+    SECTION("Strip and prefixes")
+    {
+        STATIC_REQUIRE(Lud::Strip("  \t test \r\n") == "test");
+        STATIC_REQUIRE(Lud::LStrip("  test  ") == "test  ");
+        STATIC_REQUIRE(Lud::RStrip("  test  ") == "  test");
+        STATIC_REQUIRE(Lud::Strip("    ").empty());
+        STATIC_REQUIRE(Lud::RemovePrefix("--flag", "--") == "flag");
+        STATIC_REQUIRE(Lud::RemoveSuffix("10ms", "ms") == "10");
+    }
+
+    SECTION("Integers")
+    {
+        STATIC_REQUIRE(Lud::is_num<int>(" -1234 ").value() == -1234);
+        STATIC_REQUIRE(Lud::is_num<uint64_t>("18446744073709551615").value() == 18446744073709551615ULL);
+        STATIC_REQUIRE(!Lud::is_num<uint8_t>("256"));
+        STATIC_REQUIRE(Lud::is_num<uint8_t>("  FF", 16).value() == 255);
+        STATIC_REQUIRE(Lud::is_num<uint8_t, 2>("11111111").value() == 255);
+        STATIC_REQUIRE(!Lud::is_num<uint8_t>("0xFF", 16));
+        STATIC_REQUIRE(Lud::parse_integer<int, 8>{}("377") == 255);
+    }
+
+    SECTION("Split into fixed capacity")
+    {
+        constexpr auto parts = Lud::Split<Lud::static_vector<std::string_view, 4>>("This is a test", ' ');
+        STATIC_REQUIRE(parts.size() == 4);
+        STATIC_REQUIRE(parts[3] == "test");
+
+        auto runtime = Lud::Split<Lud::static_vector<std::string_view, 4>>("This is a test", "is", 1);
+        REQUIRE(runtime.size() == 2);
+        REQUIRE(runtime[1] == " is a test");
+        REQUIRE_THROWS_AS((Lud::Split<Lud::static_vector<std::string_view, 2>>("a b c", ' ')), std::length_error);
+    }
+
+    SECTION("Literal tables")
+    {
+        constexpr auto names = Lud::SplitArray<3>("get, post, put", ", ");
+        STATIC_REQUIRE(names[1] == "post");
+
+        constexpr auto ports = Lud::ParseArray<uint16_t, 4>("80, 443,8080 , 65535", ',');
+        STATIC_REQUIRE(ports == std::array<uint16_t, 4>{80, 443, 8080, 65535});
+
+        constexpr auto masks = Lud::ParseArray<uint8_t, 2, 16>("ff|0F", '|');
+        STATIC_REQUIRE(masks[0] == 0xff);
+        STATIC_REQUIRE(masks[1] == 0x0f);
+    }
+}
+
+TEST_CASE("Hex and base64", "[parse][strings][codec]")
+{
+    const auto bytes = [](std::string_view str) {
+        return std::span(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+    };
+    std::vector<uint8_t> out;
+
+    SECTION("Known values")
+    {
+        REQUIRE(Lud::HexEncode(bytes("\x01\xab\xff")) == "01abff");
+        REQUIRE(Lud::HexEncode(bytes("\x01\xab\xff"), true) == "01ABFF");
+        REQUIRE(Lud::HexDecode("01aBfF", out).count == 3);
+        REQUIRE(out == std::vector<uint8_t>{0x01, 0xab, 0xff});
+
+        // RFC 4648 test vectors
+        const std::pair<std::string_view, std::string_view> vectors[] = {
+            {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"},
+            {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"},
+        };
+        for (const auto& [plain, encoded] : vectors)
+        {
+            REQUIRE(Lud::Base64Encode(bytes(plain)) == encoded);
+            out.clear();
+            REQUIRE(Lud::Base64Decode(encoded, out));
+            REQUIRE(std::string_view(reinterpret_cast<const char*>(out.data()), out.size()) == plain);
+            out.clear();
+            // without padding
+            REQUIRE(Lud::Base64Decode(encoded.substr(0, encoded.find('=')), out).count == plain.size());
+        }
+    }
+
+    SECTION("Round trip")
+    {
+        std::vector<uint8_t> data;
+        for (size_t i = 0; i < 300; i++)
+        {
+            data.push_back(static_cast<uint8_t>(i * 7 + i / 5));
+        }
+        for (size_t len = 0; len <= data.size(); len++)
+        {
+            const std::span<const uint8_t> input(data.data(), len);
+            out.clear();
+            REQUIRE(Lud::HexDecode(Lud::HexEncode(input), out).count == len);
+            REQUIRE(std::ranges::equal(out, input));
+            out.clear();
+            REQUIRE(Lud::Base64Decode(Lud::Base64Encode(input), out).count == len);
+            REQUIRE(std::ranges::equal(out, input));
+        }
+    }
+
+    SECTION("Appends to the output")
+    {
+        std::string text = "id=";
+        REQUIRE(Lud::HexEncode(text, bytes("\x10")) == "id=10");
+        REQUIRE(Lud::Base64Encode(text, bytes("a")) == "id=10YQ==");
+
+        out = {7};
+        REQUIRE(Lud::HexDecode("08", out));
+        REQUIRE(Lud::Base64Decode("CQ==", out));
+        REQUIRE(out == std::vector<uint8_t>{7, 8, 9});
+    }
+
+    SECTION("First invalid char")
+    {
+        const std::string hex = std::string(70, 'f');
+        for (size_t pos : {0, 1, 17, 40, 69})
+        {
+            std::string bad = hex;
+            bad[pos] = 'g';
+            out = {1, 2};
+            const auto res = Lud::HexDecode(bad, out);
+            REQUIRE_FALSE(res);
+            REQUIRE(res.error_offset == pos);
+            REQUIRE(out == std::vector<uint8_t>{1, 2});
+        }
+        REQUIRE(Lud::HexDecode("abc", out).error_offset == 2);
+
+        const std::string base64 = std::string(100, 'Q');
+        for (size_t pos : {0, 3, 21, 64, 99})
+        {
+            std::string bad = base64;
+            bad[pos] = '*';
+            REQUIRE(Lud::Base64Decode(bad, out).error_offset == pos);
+        }
+        REQUIRE(Lud::Base64Decode("QUJDR", out).error_offset == 4);
+        REQUIRE(Lud::Base64Decode("Q===", out).error_offset == 1);
+        REQUIRE(Lud::Base64Decode("Zg==Zg==", out).error_offset == 2);
+        REQUIRE(Lud::Base64Decode("Zm9v\n", out).error_offset == 4);
+    }
+}
+
+TEST_CASE("Parse quantity", "[parse][numbers][real]")
+{
+    SECTION("Plain, fractions and percentages")
+    {
+        REQUIRE(Lud::ParseQuantity<double>("1.5").value() == 1.5);
+        REQUIRE(Lud::ParseQuantity<double>(" 3 / 4 ").value() == 0.75);
+        REQUIRE(Lud::ParseQuantity<double>("50 %").value() == 0.5);
+        REQUIRE(std::isnan(Lud::ParseQuantity<double>("nan").value()));
+        REQUIRE(!Lud::ParseQuantity<double>(""));
+        REQUIRE(!Lud::ParseQuantity<double>("1//2"));
+        REQUIRE(!Lud::ParseQuantity<double>("250ms"));
+    }
+
+    SECTION("Units")
+    {
+        REQUIRE(Lud::ParseQuantity<double>("250ms", {.units = Lud::units::durations}).value() == 0.25);
+        REQUIRE(Lud::ParseQuantity<double>("2 min", {.units = Lud::units::durations}).value() == 120);
+        REQUIRE(Lud::ParseQuantity<double>("3s", {.units = Lud::units::durations}).value() == 3);
+        REQUIRE(Lud::ParseQuantity<double>("4KiB", {.units = Lud::units::bytes}).value() == 4096);
+        REQUIRE(Lud::ParseQuantity<double>("10B", {.units = Lud::units::bytes}).value() == 10);
+        REQUIRE(Lud::ParseQuantity<double>("1.5G", {.units = Lud::units::si}).value() == 1.5e9);
+        REQUIRE(std::isnan(Lud::ParseQuantity<double>("nan", {.units = Lud::units::si}).value()));
+        REQUIRE(!Lud::ParseQuantity<double>("ms", {.units = Lud::units::durations}));
+        REQUIRE(!Lud::ParseQuantity<double>("4 KiBs", {.units = Lud::units::bytes}));
+        REQUIRE(!Lud::ParseQuantity<double>("4x", {.units = Lud::units::bytes}));
+    }
+
+    SECTION("Custom table")
+    {
+        static constexpr std::array<Lud::quantity_unit, 2> lengths{{{"cm", 0.01}, {"m", 1}}};
+        REQUIRE(Lud::ParseQuantity<double>("150cm", {.units = lengths}).value() == 1.5);
+        REQUIRE(Lud::ParseQuantity<float>("2m", {.units = lengths}).value() == 2.f);
+        REQUIRE(!Lud::ParseQuantity<double>("2", {.plain = false, .units = lengths}));
+    }
+
+    SECTION("Suffixes with a slash or a percent sign")
+    {
+        static constexpr std::array<Lud::quantity_unit, 3> rates{{{"MB/s", 1e6}, {"km/h", 1000}, {"%RH", 0.01}}};
+        REQUIRE(Lud::ParseQuantity<double>("5MB/s", {.units = rates}).value() == 5e6);
+        REQUIRE(Lud::ParseQuantity<double>("36 km/h", {.fraction = false, .units = rates}).value() == 36000);
+        REQUIRE(Lud::ParseQuantity<double>("40%RH", {.percentage = false, .units = rates}).value() == 40 * 0.01);
+        // no suffix matches, so the other forms still apply
+        REQUIRE(Lud::ParseQuantity<double>("1/4", {.units = rates}).value() == 0.25);
+        REQUIRE(Lud::ParseQuantity<double>("50%", {.units = rates}).value() == 0.5);
+        REQUIRE(!Lud::ParseQuantity<double>("5GB/s", {.units = rates}));
+    }
+}
+
 TEST_CASE("Is fraction", "[parse][numbers][real]")
 {
     SECTION("Simple")